@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+
+/// Bump allocator over one block: alloc() hands out aligned slices in
+/// order and reset() takes them all back at once.  Nothing is freed on
+/// its own or ever moved, so pointers into the arena stay good until the
+/// next reset(), and a reused arena never touches the heap.
+class Arena {
+public:
+  /// Make room for `bytes`; drops whatever the arena held.
+  void reserve(size_t bytes) {
+    if (bytes > capacity_) {
+      buf_.reset(new uint8_t[bytes]);
+      capacity_ = bytes;
+    }
+    used_ = 0;
+  }
+
+  void reset() { used_ = 0; }
+
+  /// Uninitialised room for `n` T, or nullptr when the arena is full.
+  template <typename T>
+  T* alloc(size_t n) {
+    size_t at = (used_ + alignof(T) - 1) & ~(alignof(T) - 1);
+    if (at > capacity_ || n > (capacity_ - at) / sizeof(T)) return nullptr;
+    used_ = at + n * sizeof(T);
+    return reinterpret_cast<T*>(buf_.get() + at);
+  }
+
+  size_t used()     const { return used_; }
+  size_t capacity() const { return capacity_; }
+
+private:
+  std::unique_ptr<uint8_t[]> buf_;
+  size_t capacity_ = 0;
+  size_t used_     = 0;
+};
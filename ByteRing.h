@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+/// Lock-free single-producer / single-consumer byte ring.
+///
+/// The producer pushes whole chunks (a bulk UART read); the consumer walks
+/// the stored bytes in place through peek()/consume(), so nothing is copied
+/// a second time.  When the ring is full, incoming bytes are dropped and
+/// counted rather than overwriting data the consumer has not seen.
+template <size_t N>
+class ByteRing {
+  static_assert(N && (N & (N - 1)) == 0, "ByteRing size must be a power of two");
+
+public:
+  static constexpr size_t capacity() { return N; }
+
+  /// Producer: append up to `n` bytes; returns how many were stored.
+  size_t write(const uint8_t* src, size_t n) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t room = N - (head - tail);
+    size_t take = n < room ? n : room;
+
+    size_t at    = head & (N - 1);
+    size_t first = take < N - at ? take : N - at;
+    memcpy(buf_ + at, src, first);
+    memcpy(buf_, src + first, take - first);
+    head_.store(head + take, std::memory_order_release);
+
+    if (take < n) overruns_.fetch_add(n - take, std::memory_order_relaxed);
+    size_t used = head + take - tail;
+    if (used > highWater_.load(std::memory_order_relaxed))
+      highWater_.store(used, std::memory_order_relaxed);
+    return take;
+  }
+
+  /// Consumer: contiguous run of unread bytes; 0 when empty.
+  size_t peek(const uint8_t*& p) const {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t head = head_.load(std::memory_order_acquire);
+    size_t at   = tail & (N - 1);
+    size_t run  = head - tail;
+    p = buf_ + at;
+    return run < N - at ? run : N - at;
+  }
+
+  /// Consumer: release `n` bytes returned by peek().
+  void consume(size_t n) {
+    tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                std::memory_order_release);
+  }
+
+  size_t size() const {
+    return head_.load(std::memory_order_acquire)
+         - tail_.load(std::memory_order_acquire);
+  }
+
+  /// Bytes dropped because the ring was full.
+  uint32_t overruns() const { return overruns_.load(std::memory_order_relaxed); }
+
+  /// Deepest fill level seen since boot.
+  size_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+
+private:
+  uint8_t             buf_[N];
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+  std::atomic<uint32_t> overruns_{0};
+  std::atomic<size_t> highWater_{0};
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+/// On-card layout of a raw NMEA capture, shared by NmeaCapture on the
+/// device and tools/nmea_replay on the host.
+///
+///   "NMEACAP1"                          8-byte magic
+///   { uint32 us, uint16 len, bytes[len] }  repeated, little-endian
+///
+/// `us` is micros() when the chunk came off the UART; it wraps every
+/// ~71 minutes, so readers must only ever look at differences.
+namespace capture {
+
+static constexpr char     MAGIC[8]   = { 'N', 'M', 'E', 'A', 'C', 'A', 'P', '1' };
+static constexpr uint32_t HEADER_LEN = 6;
+
+inline void putHeader(uint8_t* p, uint32_t us, uint16_t len) {
+  p[0] = uint8_t(us);       p[1] = uint8_t(us >> 8);
+  p[2] = uint8_t(us >> 16); p[3] = uint8_t(us >> 24);
+  p[4] = uint8_t(len);      p[5] = uint8_t(len >> 8);
+}
+
+inline void getHeader(const uint8_t* p, uint32_t& us, uint16_t& len) {
+  us  = uint32_t(p[0]) | uint32_t(p[1]) << 8
+      | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+  len = uint16_t(p[4] | p[5] << 8);
+}
+
+}  // namespace capture
@@ -0,0 +1,86 @@
+#include "CourseImage.h"
+#include <string.h>
+#include <new>
+
+using namespace courseimg;
+
+bool CourseImage::open(const uint8_t* data, size_t n) {
+  data_ = nullptr;
+  size_ = count_ = maxHoles_ = maxHazards_ = 0;
+  index_.attach(nullptr, 0);
+
+  Header h;
+  if (n < sizeof(h)) return false;
+  memcpy(&h, data, sizeof(h));
+  if (h.magic != MAGIC || h.version != VERSION || h.size > n) return false;
+  if (size_t(h.entries) + size_t(h.count) * sizeof(Entry) > h.size ||
+      size_t(h.tree) + size_t(h.count) * CourseIndex::NODE_BYTES > h.size ||
+      (h.entries | h.tree) % 4)
+    return false;
+
+  data_       = data;
+  size_       = h.size;
+  count_      = h.count;
+  maxHoles_   = h.maxHoles;
+  maxHazards_ = h.maxHazards;
+  entries_    = reinterpret_cast<const Entry*>(data + h.entries);
+  index_.attach(data + h.tree, h.count);
+  return true;
+}
+
+const char* CourseImage::string(uint32_t at) const {
+  return at < size_ ? reinterpret_cast<const char*>(data_ + at) : "";
+}
+
+const char* CourseImage::name(size_t i) const {
+  return i < count_ ? string(entries_[i].name) : "";
+}
+
+Geo CourseImage::location(size_t i) const {
+  return i < count_ ? entries_[i].location : Geo{};
+}
+
+size_t CourseImage::arenaBytes() const {
+  // plus worst-case padding in front of each array
+  return maxHazards_ * sizeof(Hazard) + alignof(Hazard)
+       + maxHoles_ * sizeof(Hole) + alignof(Hole);
+}
+
+bool CourseImage::decode(size_t i, Course& out, Arena& arena) const {
+  if (i >= count_) return false;
+  const Entry& e = entries_[i];
+  size_t end = size_t(e.block) + e.holes * sizeof(HoleRecord)
+             + e.hazards * sizeof(HazardRecord) + e.points * sizeof(Geo);
+  if (e.block % 4 || end > size_ || e.boundary > e.points) return false;
+
+  const HoleRecord*   hs = reinterpret_cast<const HoleRecord*>(data_ + e.block);
+  const HazardRecord* zs = reinterpret_cast<const HazardRecord*>(hs + e.holes);
+  const Geo*          ps = reinterpret_cast<const Geo*>(zs + e.hazards);
+
+  arena.reset();
+  Hazard* hazards = arena.alloc<Hazard>(e.hazards);
+  Hole*   holes   = arena.alloc<Hole>(e.holes);
+  if (!hazards || !holes) return false;
+
+  for (size_t k = 0; k < e.hazards; ++k)
+    new (&hazards[k]) Hazard{ zs[k].loc, zs[k].radius, HazardType(zs[k].type) };
+
+  for (size_t k = 0; k < e.holes; ++k) {
+    const HoleRecord& h = hs[k];
+    if (h.hazards + h.nHazards > e.hazards || h.layups + h.nLayups > e.points ||
+        h.green + h.nGreen > e.points)
+      return false;
+    new (&holes[k]) Hole{ h.number, h.par, h.pin, h.front, h.back, h.tee,
+                          h.hasTee != 0,
+                          Span<Hazard>(hazards + h.hazards, h.nHazards),
+                          Span<Geo>(ps + h.layups, h.nLayups),
+                          Span<Geo>(ps + h.green, h.nGreen) };
+  }
+
+  out = Course{ string(e.name), e.location,
+                Span<Hole>(holes, e.holes),
+                Span<Geo>(ps, e.boundary),
+                geo::LocalFrame(e.origin, geo::Earth(e.earth), e.mPerE7Lat,
+                                e.mPerE7Lon, e.xSlope, e.ySlope) };
+  return true;
+}
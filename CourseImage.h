@@ -0,0 +1,112 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Arena.h"
+#include "CourseIndex.h"
+#include "CourseTypes.h"
+
+/// Layout of a compiled course library, written by tools/course_compiler
+/// and read in place by CourseImage.
+///
+///   Header
+///   Entry[count]                 one per course, in name order
+///   CourseIndex tree[count]      prebuilt over the entries' locations
+///   per course:  HoleRecord[] HazardRecord[] Geo[]
+///   strings                      NUL-terminated, referenced by offset
+///
+/// Little-endian, every record a multiple of 4 bytes and free of pointers,
+/// so the image is used straight out of a flash mapping.  Offsets are from
+/// the start of the image; record indices are within their course.
+namespace courseimg {
+
+static constexpr uint32_t MAGIC   = 0x42444347;   // "GCDB"
+static constexpr uint16_t VERSION = 2;
+
+struct Header {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t reserved;
+  uint32_t count;        // courses
+  uint32_t entries;      // offset of Entry[count]
+  uint32_t tree;         // offset of the CourseIndex nodes
+  uint32_t size;         // whole image
+  uint16_t maxHoles, maxHazards;   // in any one course
+};
+
+struct Entry {
+  uint32_t name;         // string offset
+  Geo      location;
+  uint32_t block;        // offset of the course's HoleRecord[]
+  uint16_t holes, hazards;
+  uint16_t points, boundary;   // the first `boundary` points outline it
+  Geo      origin;       // geo::LocalFrame
+  uint8_t  earth, pad[3];
+  float    mPerE7Lat, mPerE7Lon, xSlope, ySlope;
+};
+
+struct HoleRecord {
+  uint16_t number;
+  uint8_t  par, hasTee;
+  Geo      pin, front, back, tee;
+  uint16_t hazards, nHazards;
+  uint16_t layups, nLayups;
+  uint16_t green, nGreen;
+};
+
+struct HazardRecord {
+  Geo      loc;
+  float    radius;
+  uint8_t  type, pad[3]; // HazardType
+};
+
+static_assert(sizeof(Header)       == 28, "image layout");
+static_assert(sizeof(Entry)        == 52, "image layout");
+static_assert(sizeof(HoleRecord)   == 48, "image layout");
+static_assert(sizeof(HazardRecord) == 16, "image layout");
+
+}  // namespace courseimg
+
+/// A course image in memory or mapped from flash.
+///
+/// Names, locations and the nearest-course lookup read the image directly;
+/// only a course being played is decoded, its Hole and Hazard records
+/// into an Arena and its points and name left pointing into the image.
+/// What stays in RAM is one arena sized for the largest course, however
+/// many the image holds.
+class CourseImage {
+public:
+  /// Check the header of the `n` bytes at `data`, which must stay mapped
+  /// while the image is in use.
+  bool open(const uint8_t* data, size_t n);
+
+  size_t size() const { return count_; }
+  size_t bytes() const { return size_; }
+
+  const char* name(size_t i) const;
+  Geo location(size_t i) const;
+
+  /// Up to `k` course indices nearest `from`, closest first.
+  size_t nearest(const Geo& from, size_t k, uint32_t* out) const {
+    return index_.nearest(from, k, out);
+  }
+
+  /// Arena capacity decode() needs for any course in the image.
+  size_t arenaBytes() const;
+
+  /// Course `i` into `out`, its holes and hazards into `arena` after
+  /// resetting it.  False if `i` is out of range, its records run past the
+  /// image or the arena is too small.
+  bool decode(size_t i, Course& out, Arena& arena) const;
+
+private:
+  const char* string(uint32_t at) const;
+
+  const uint8_t*          data_       = nullptr;
+  size_t                  size_       = 0;
+  size_t                  count_      = 0;
+  size_t                  maxHoles_   = 0;
+  size_t                  maxHazards_ = 0;
+  const courseimg::Entry* entries_    = nullptr;
+  CourseIndex             index_;
+};
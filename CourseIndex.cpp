@@ -0,0 +1,102 @@
+#include "CourseIndex.h"
+#include <math.h>
+#include <algorithm>
+
+static constexpr double RAD_PER_E7 = M_PI / 180.0 / 1e7;
+
+void CourseIndex::toUnit(const Geo& g, float p[3]) {
+  double lat = g.lat * RAD_PER_E7, lon = g.lon * RAD_PER_E7;
+  double c = cos(lat);
+  p[0] = float(c * cos(lon));
+  p[1] = float(c * sin(lon));
+  p[2] = float(sin(lat));
+}
+
+void CourseIndex::build(const Geo* locations, size_t n) {
+  built_.resize(n);
+  for (size_t i = 0; i < n; ++i) {
+    toUnit(locations[i], built_[i].p);
+    built_[i].id = uint32_t(i);
+  }
+  split(0, n);
+  nodes_ = built_.data();
+  n_     = n;
+}
+
+void CourseIndex::attach(const void* nodes, size_t n) {
+  built_.clear();
+  built_.shrink_to_fit();
+  nodes_ = static_cast<const Node*>(nodes);
+  n_     = n;
+}
+
+// [lo, hi) becomes a subtree rooted at its midpoint
+void CourseIndex::split(size_t lo, size_t hi) {
+  if (hi - lo < 2) {
+    if (hi > lo) built_[lo].axis = 0;
+    return;
+  }
+
+  float mn[3] = { 2, 2, 2 }, mx[3] = { -2, -2, -2 };
+  for (size_t i = lo; i < hi; ++i)
+    for (int a = 0; a < 3; ++a) {
+      mn[a] = std::min(mn[a], built_[i].p[a]);
+      mx[a] = std::max(mx[a], built_[i].p[a]);
+    }
+  uint8_t axis = 0;
+  for (uint8_t a = 1; a < 3; ++a)
+    if (mx[a] - mn[a] > mx[axis] - mn[axis]) axis = a;
+
+  size_t mid = lo + (hi - lo) / 2;
+  std::nth_element(built_.begin() + lo, built_.begin() + mid,
+                   built_.begin() + hi,
+                   [axis](const Node& a, const Node& b) {
+                     return a.p[axis] < b.p[axis];
+                   });
+  built_[mid].axis = axis;
+  split(lo, mid);
+  split(mid + 1, hi);
+}
+
+void CourseIndex::search(size_t lo, size_t hi, const float q[3], size_t k,
+                         std::vector<Hit>& heap) const {
+  if (lo >= hi) return;
+  size_t mid = lo + (hi - lo) / 2;
+  const Node& n = nodes_[mid];
+
+  float dx = n.p[0] - q[0], dy = n.p[1] - q[1], dz = n.p[2] - q[2];
+  float d2 = dx * dx + dy * dy + dz * dz;
+  if (heap.size() < k) {
+    heap.push_back(Hit{ d2, n.id });
+    std::push_heap(heap.begin(), heap.end());
+  } else if (d2 < heap.front().d2) {
+    std::pop_heap(heap.begin(), heap.end());
+    heap.back() = Hit{ d2, n.id };
+    std::push_heap(heap.begin(), heap.end());
+  }
+
+  // near side first; the far side only if the splitting plane is closer
+  // than the worst hit kept so far
+  float off = q[n.axis] - n.p[n.axis];
+  bool left = off < 0.0f;
+  if (left) search(lo, mid, q, k, heap);
+  else      search(mid + 1, hi, q, k, heap);
+  if (heap.size() < k || off * off < heap.front().d2) {
+    if (left) search(mid + 1, hi, q, k, heap);
+    else      search(lo, mid, q, k, heap);
+  }
+}
+
+size_t CourseIndex::nearest(const Geo& from, size_t k, uint32_t* out) const {
+  if (!k || !n_) return 0;
+  float q[3];
+  toUnit(from, q);
+
+  std::vector<Hit> heap;
+  heap.reserve(k);
+  search(0, n_, q, k, heap);
+
+  std::sort_heap(heap.begin(), heap.end());
+  for (size_t i = 0; i < heap.size(); ++i) out[i] = heap[i].id;
+  return heap.size();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Geo.h"
+
+/// k-nearest lookup over course locations.
+///
+/// Locations are stored as unit vectors on the sphere in a static k-d tree
+/// (median split on the widest axis, laid out in place), so ranking by
+/// chord length matches ranking by great-circle distance with no special
+/// cases at the poles or the antimeridian.  A query visits O(log n + k)
+/// nodes for the libraries we carry.
+class CourseIndex {
+public:
+  /// Rebuild from `n` locations; the ids returned later are their indices.
+  void build(const Geo* locations, size_t n);
+
+  /// Search a tree stored by an earlier build() (data() / bytes()), e.g.
+  /// in a course image, without copying it; `nodes` must outlive the
+  /// index and be 4-byte aligned.
+  void attach(const void* nodes, size_t n);
+
+  /// Up to `k` location ids nearest `from`, closest first, into `out`.
+  /// Returns how many were written.
+  size_t nearest(const Geo& from, size_t k, uint32_t* out) const;
+
+  size_t size() const { return n_; }
+
+  /// The tree as laid out, for storing.
+  static constexpr size_t NODE_BYTES = 20;
+  const void* data()  const { return nodes_; }
+  size_t      bytes() const { return n_ * NODE_BYTES; }
+
+private:
+  struct Node {
+    float    p[3];
+    uint32_t id;
+    uint8_t  axis;
+    uint8_t  pad[3];   // named, so stored trees are byte-for-byte repeatable
+  };
+  static_assert(sizeof(Node) == NODE_BYTES, "stored trees depend on it");
+
+  struct Hit {
+    float    d2;
+    uint32_t id;
+    bool operator<(const Hit& o) const { return d2 < o.d2; }
+  };
+
+  static void toUnit(const Geo& g, float p[3]);
+  void split(size_t lo, size_t hi);
+  void search(size_t lo, size_t hi, const float q[3], size_t k,
+              std::vector<Hit>& heap) const;
+
+  std::vector<Node> built_;
+  const Node* nodes_ = nullptr;   // built_ or attached
+  size_t      n_     = 0;
+};
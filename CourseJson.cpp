@@ -0,0 +1,193 @@
+#include "CourseJson.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Field order; also the names used in problem reports
+static const char* const FIELD_NAMES[] = {
+  "", "name", "number", "par", "type", "radius", "lat", "lon",
+  "location", "pin", "front", "back", "tee", "layups", "green", "boundary",
+  "courses", "holes", "hazards"
+};
+
+void CourseJsonReader::enter(Ctx ctx) {
+  stack_[depth_]  = ctx;
+  fields_[depth_] = key_;
+  ++depth_;
+  key_ = Field::None;
+}
+
+void CourseJsonReader::beginPoint() {
+  lat_ = lon_ = 0;
+  hasLat_ = hasLon_ = false;
+  pointAt_ = reader_.offset();
+}
+
+void CourseJsonReader::beginObject() {
+  Ctx ctx = Ctx::Skip;
+  if (!depth_) {
+    ctx = Ctx::Root;
+  } else {
+    switch (top()) {
+      case Ctx::Courses:
+        course_.name.clear();
+        course_.location = Geo{};
+        course_.holes.clear();
+        course_.boundary.clear();
+        ctx = Ctx::Course;
+        break;
+      case Ctx::Course:
+        if (key_ == Field::Location) ctx = Ctx::Point;
+        break;
+      case Ctx::Holes:
+        course_.holes.emplace_back();
+        ctx = Ctx::Hole;
+        break;
+      case Ctx::Hole:
+        if (key_ == Field::Pin || key_ == Field::Front || key_ == Field::Back ||
+            key_ == Field::Tee)
+          ctx = Ctx::Point;
+        break;
+      case Ctx::Hazards:
+        course_.holes.back().hazards.emplace_back();
+        ctx = Ctx::Hazard;
+        break;
+      case Ctx::Points:
+        ctx = Ctx::Point;
+        break;
+      default:
+        break;
+    }
+  }
+  if (ctx == Ctx::Point || ctx == Ctx::Hazard) beginPoint();
+  enter(ctx);
+}
+
+void CourseJsonReader::beginArray() {
+  Ctx ctx = Ctx::Skip;
+  if (depth_) {
+    switch (top()) {
+      case Ctx::Root:
+        if (key_ == Field::Courses) ctx = Ctx::Courses;
+        break;
+      case Ctx::Course:
+        if      (key_ == Field::Holes)    ctx = Ctx::Holes;
+        else if (key_ == Field::Boundary) ctx = Ctx::Points;
+        break;
+      case Ctx::Hole:
+        if      (key_ == Field::Hazards)  ctx = Ctx::Hazards;
+        else if (key_ == Field::Layups || key_ == Field::Green) ctx = Ctx::Points;
+        break;
+      default:
+        break;
+    }
+  }
+  enter(ctx);
+}
+
+// The finished point, or 0, 0 after reporting what is wrong with it
+Geo CourseJsonReader::endPoint(Field field) {
+  const char* what = nullptr;
+  if (!hasLat_ || !hasLon_)
+    what = "lat and lon must both be numbers";
+  else if (!(fabs(lat_) <= 90) || !(fabs(lon_) <= 180))
+    what = "off the globe";
+  else if (lat_ == 0 && lon_ == 0)
+    what = "0, 0 (unset?)";
+  if (!what) return geo::fromDegrees(lat_, lon_);
+
+  if (onProblem_) {
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), "course %zu", count_ + 1);
+    if (field != Field::Location && field != Field::Boundary)
+      n += snprintf(buf + n, sizeof(buf) - n, " hole %zu", course_.holes.size());
+    snprintf(buf + n, sizeof(buf) - n, " %s: %.7f, %.7f %s",
+             FIELD_NAMES[uint8_t(field)], lat_, lon_, what);
+    onProblem_(pointAt_, buf);
+  }
+  return Geo{};
+}
+
+void CourseJsonReader::endObject() {
+  Ctx   ctx   = top();
+  Field field = fields_[depth_ - 1];
+  --depth_;
+  key_ = Field::None;
+
+  switch (ctx) {
+    case Ctx::Course:
+      ++count_;
+      if (onCourse_) onCourse_(course_);
+      break;
+
+    case Ctx::Hazard:
+      course_.holes.back().hazards.back().loc = endPoint(Field::Hazards);
+      break;
+
+    case Ctx::Point: {
+      // a lone point is for its key; a list member for the list's key
+      Ctx parent = top();
+      if (parent == Ctx::Points) field = fields_[depth_ - 1];
+      Geo g = endPoint(field);
+      if (parent == Ctx::Course) {
+        course_.location = g;
+        break;
+      }
+      JsonHole* h = course_.holes.empty() ? nullptr : &course_.holes.back();
+      switch (field) {
+        case Field::Pin:      h->pin   = g; break;
+        case Field::Front:    h->front = g; break;
+        case Field::Back:     h->back  = g; break;
+        case Field::Tee:      h->tee   = g; break;
+        case Field::Layups:   h->layups.push_back(g); break;
+        case Field::Green:    h->green.push_back(g); break;
+        case Field::Boundary: course_.boundary.push_back(g); break;
+        default: break;
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+}
+
+void CourseJsonReader::endArray() {
+  --depth_;
+  key_ = Field::None;
+}
+
+void CourseJsonReader::key(const char* s, size_t n) {
+  key_ = Field::None;
+  for (uint8_t f = 1; f < sizeof(FIELD_NAMES) / sizeof(FIELD_NAMES[0]); ++f)
+    if (strlen(FIELD_NAMES[f]) == n && !memcmp(FIELD_NAMES[f], s, n)) {
+      key_ = Field(f);
+      break;
+    }
+  // "tee" counts as given whatever it holds
+  if (key_ == Field::Tee && top() == Ctx::Hole) course_.holes.back().hasTee = true;
+}
+
+void CourseJsonReader::string(const char* s, size_t n) {
+  if (!depth_) return;
+  if (top() == Ctx::Course && key_ == Field::Name)
+    course_.name.assign(s, n);
+  else if (top() == Ctx::Hazard && key_ == Field::Type)
+    course_.holes.back().hazards.back().type.assign(s, n);
+  key_ = Field::None;
+}
+
+void CourseJsonReader::number(double v) {
+  if (!depth_) return;
+  Ctx ctx = top();
+  if (ctx == Ctx::Point || ctx == Ctx::Hazard) {
+    if      (key_ == Field::Lat) { lat_ = v; hasLat_ = true; }
+    else if (key_ == Field::Lon) { lon_ = v; hasLon_ = true; }
+    else if (key_ == Field::Radius && ctx == Ctx::Hazard)
+      course_.holes.back().hazards.back().radius = float(v);
+  } else if (ctx == Ctx::Hole) {
+    if      (key_ == Field::Number) course_.holes.back().number = int(v);
+    else if (key_ == Field::Par)    course_.holes.back().par    = int(v);
+  }
+  key_ = Field::None;
+}
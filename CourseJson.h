@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Geo.h"
+#include "JsonReader.h"
+
+// —— Course records as the JSON gives them ——
+
+struct JsonHazard {
+  std::string type;
+  Geo   loc{};
+  float radius = 0.0f;
+};
+
+struct JsonHole {
+  int  number = 0;
+  int  par    = 4;
+  Geo  pin{}, front{}, back{}, tee{};
+  bool hasTee = false;
+  std::vector<JsonHazard> hazards;
+  std::vector<Geo> layups;
+  std::vector<Geo> green;
+};
+
+struct JsonCourse {
+  std::string name;
+  Geo location{};
+  std::vector<JsonHole> holes;
+  std::vector<Geo> boundary;
+};
+
+/// Builds courses straight from a course JSON byte stream.
+///
+///   { "courses": [ { "name", "location", "holes": [ { "number", "par",
+///     "pin", "front", "back", "tee", "hazards", "layups", "green" } ],
+///     "boundary" } ] }
+///
+/// Each course is handed to the callback as soon as its object closes and
+/// its record is then reused, so what is held is a JsonReader plus one
+/// course, however many the stream carries.  Unknown keys are skipped.
+/// Points ({"lat", "lon"} objects) off the globe, at 0, 0 or missing a
+/// coordinate go to the problem callback with their byte offset and the
+/// parse carries on, leaving the point at 0, 0.
+class CourseJsonReader : private JsonReader::Handler {
+public:
+  using CourseFn  = std::function<void(const JsonCourse&)>;
+  using ProblemFn = std::function<void(size_t offset, const char* what)>;
+
+  explicit CourseJsonReader(CourseFn onCourse, ProblemFn onProblem = nullptr)
+    : reader_(*this), onCourse_(std::move(onCourse)),
+      onProblem_(std::move(onProblem)) {}
+
+  bool feed(const char* p, size_t n) { return reader_.feed(p, n); }
+  bool finish() { return reader_.finish(); }
+
+  size_t offset() const { return reader_.offset(); }
+  const char* error() const { return reader_.error(); }
+
+  /// Courses handed over so far.
+  size_t courses() const { return count_; }
+
+private:
+  // what the object or array being read is
+  enum class Ctx : uint8_t {
+    Root, Courses, Course, Holes, Hole, Hazards, Hazard, Points, Point, Skip
+  };
+  // which field a point, a point list or a scalar is for
+  enum class Field : uint8_t {
+    None, Name, Number, Par, Type, Radius, Lat, Lon,
+    Location, Pin, Front, Back, Tee, Layups, Green, Boundary,
+    Courses, Holes, Hazards
+  };
+
+  void beginObject() override;
+  void endObject() override;
+  void beginArray() override;
+  void endArray() override;
+  void key(const char* s, size_t n) override;
+  void string(const char* s, size_t n) override;
+  void number(double v) override;
+
+  void enter(Ctx ctx);
+  Ctx  top() const { return stack_[depth_ - 1]; }
+  void beginPoint();
+  Geo  endPoint(Field field);
+
+  JsonReader reader_;
+  CourseFn   onCourse_;
+  ProblemFn  onProblem_;
+
+  Ctx      stack_[JsonReader::MAX_DEPTH];
+  Field    fields_[JsonReader::MAX_DEPTH];   // what each level is for
+  uint8_t  depth_ = 0;
+  Field    key_   = Field::None;
+
+  JsonCourse course_;
+  double     lat_ = 0, lon_ = 0;          // of the point being read
+  bool       hasLat_ = false, hasLon_ = false;
+  size_t     pointAt_ = 0;                // its offset
+  size_t     count_ = 0;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Geo.h"
+
+/// Read-only view of `n` contiguous records; enough of std::vector's
+/// interface (size, empty, [], range-for) that callers don't care whether
+/// the records live in flash or RAM.
+template <typename T>
+class Span {
+public:
+  constexpr Span() = default;
+  constexpr Span(const T* data, size_t n) : data_(data), size_(n) {}
+
+  constexpr const T* begin()  const { return data_; }
+  constexpr const T* end()    const { return data_ + size_; }
+  constexpr const T* data()   const { return data_; }
+  constexpr size_t   size()   const { return size_; }
+  constexpr bool     empty()  const { return size_ == 0; }
+  constexpr const T& operator[](size_t i) const { return data_[i]; }
+
+private:
+  const T* data_ = nullptr;
+  size_t   size_ = 0;
+};
+
+/// Earth model for on-course distances.  The sphere is up to 0.5% off the
+/// WGS84 geodesic; the ellipsoid costs nothing extra per fix.  Baked into
+/// each course's frame by tools/course_compiler.
+static constexpr geo::Earth COURSE_EARTH = geo::Earth::Wgs84;
+
+// —— Data types ——
+// What CourseImage decodes a course into.  A course's holes and hazards
+// sit in one Arena, each contiguous; points and names stay in the image.
+
+/// What a hazard is; course_compiler maps the JSON "type" onto it.
+enum class HazardType : uint8_t { Other, Bunker, Water, Trees, OutOfBounds };
+
+/// Short label for the hole page ("bunker", "water", ...).
+inline const char* hazardName(HazardType t) {
+  static const char* const NAMES[] = {
+    "hazard", "bunker", "water", "trees", "OB"
+  };
+  return uint8_t(t) < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[uint8_t(t)]
+                                                       : NAMES[0];
+}
+
+struct Hazard {
+  Geo   loc;
+  float radius;       // optional "radius" (m): half its depth along the line
+  HazardType type;
+};
+
+struct Hole {
+  int   number;
+  int   par;
+  Geo   pin;
+  Geo   front;
+  Geo   back;
+  Geo   tee;          // optional "tee"; else the previous hole's green
+  bool  hasTee;       // "tee" was given
+  Span<Hazard> hazards;
+  Span<Geo>    layups;   // optional "layups": [{lat, lon}, ...]
+  Span<Geo>    green;    // optional "green" outline: [{lat, lon}, ...]
+};
+
+struct Course {
+  const char* name;
+  Geo location;
+  Span<Hole> holes;
+  Span<Geo>  boundary;     // optional "boundary" outline: [{lat, lon}, ...]
+  geo::LocalFrame frame;   // centred on the holes; for on-course distances
+};
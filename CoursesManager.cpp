@@ -1,50 +1,83 @@
 #include "CoursesManager.h"
-#include "courses_data.h"  // your R"RAWJSON(...) coursesJson string
-#include <ArduinoJson.h>
+#include "courses_db.h"    // generated from courses_data.h
+#include <algorithm>
+
+// fence sizes where the course data gives no extent
+static constexpr float TEE_FENCE_M    = 15.0f;
+static constexpr float GREEN_FENCE_M  = 8.0f;
+static constexpr float HAZARD_FENCE_M = 10.0f;
 
 void CoursesManager::beginFromFlash() {
-  DynamicJsonDocument doc(60 * 1024);
-  auto err = deserializeJson(doc, coursesJson);
-  if (err) {
-    Serial.print("JSON parse failed: ");
-    Serial.println(err.c_str());
-    return;
+  uint32_t t0 = micros();
+  uint32_t heap0 = ESP.getFreeHeap();
+
+  const char* source = "partition";
+  const esp_partition_t* part = esp_partition_find_first(
+    ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "courses");
+  const void* map = nullptr;
+  if (!part ||
+      esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &map,
+                         &map_) != ESP_OK ||
+      !image_.open(static_cast<const uint8_t*>(map), part->size)) {
+    if (map) esp_partition_munmap(map_);
+    source = "firmware";
+    image_.open(coursedb::IMAGE, sizeof(coursedb::IMAGE));
   }
-  parseCourses(doc["courses"].as<JsonArray>());
+  arena_.reserve(image_.arenaBytes());
+
+  Serial.printf("Courses: %u from %s in %lu us, %d bytes of heap\n",
+                unsigned(image_.size()), source,
+                (unsigned long)(micros() - t0),
+                int(heap0) - int(ESP.getFreeHeap()));
   if (onLoaded_) onLoaded_();
 }
 
-void CoursesManager::parseCourses(JsonArray arr) {
-  for (JsonObject courseJson : arr) {
-    Course c;
-    c.name = courseJson["name"].as<const char*>();
-    c.location.lat = courseJson["location"]["lat"].as<double>();
-    c.location.lon = courseJson["location"]["lon"].as<double>();
-
-    for (JsonObject holeJson : courseJson["holes"].as<JsonArray>()) {
-      Hole h;
-      h.number = holeJson["number"].as<int>();
-      h.par = holeJson.containsKey("par")
-                ? holeJson["par"].as<int>()
-                : 4;
-      h.pin.lat = holeJson["pin"]["lat"].as<double>();
-      h.pin.lon = holeJson["pin"]["lon"].as<double>();
-      h.front.lat = holeJson["front"]["lat"].as<double>();
-      h.front.lon = holeJson["front"]["lon"].as<double>();
-      h.back.lat = holeJson["back"]["lat"].as<double>();
-      h.back.lon = holeJson["back"]["lon"].as<double>();
-
-      for (JsonObject hzJson : holeJson["hazards"].as<JsonArray>()) {
-        Hazard hz;
-        hz.type = hzJson["type"].as<const char*>();
-        hz.loc.lat = hzJson["lat"].as<double>();
-        hz.loc.lon = hzJson["lon"].as<double>();
-        h.hazards.push_back(hz);
-      }
-
-      c.holes.push_back(h);
+const Course& CoursesManager::course(size_t i) {
+  if (i == courseIdx_) return course_;
+  courseIdx_ = i;
+  if (!image_.decode(i, course_, arena_)) {
+    course_ = Course{};
+    course_.name = "";
+  }
+  return course_;
+}
+
+void CoursesManager::buildFences(size_t idx, GeofenceEngine& g) {
+  g.clear();
+  if (idx >= image_.size()) return;
+  const Course& c = course(idx);
+  const geo::LocalFrame& f = c.frame;
+  g.setFrame(f);
+
+  std::vector<geo::Vec2> pts;
+  auto outline = [&](const Span<Geo>& geos) {
+    pts.clear();
+    for (const Geo& p : geos) pts.push_back(f.toLocal(p));
+    return pts.size() >= 3;
+  };
+
+  if (outline(c.boundary))
+    g.addPolygon(FenceKind::Boundary, 0, 0, pts.data(), pts.size());
+
+  for (size_t hi = 0; hi < c.holes.size(); ++hi) {
+    const Hole& h = c.holes[hi];
+    uint8_t n = uint8_t(hi);
+    if (h.hasTee)
+      g.addCircle(FenceKind::Tee, n, 0, f.toLocal(h.tee), TEE_FENCE_M);
+
+    // no outline: a circle round the pin reaching the front / back points
+    if (outline(h.green)) {
+      g.addPolygon(FenceKind::Green, n, 0, pts.data(), pts.size());
+    } else {
+      float r = std::max({ f.distance(h.pin, h.front),
+                           f.distance(h.pin, h.back), GREEN_FENCE_M });
+      g.addCircle(FenceKind::Green, n, 0, f.toLocal(h.pin), r);
     }
 
-    courses_.push_back(c);
+    for (size_t zi = 0; zi < h.hazards.size(); ++zi) {
+      const Hazard& hz = h.hazards[zi];
+      g.addCircle(FenceKind::Hazard, n, uint8_t(zi), f.toLocal(hz.loc),
+                  hz.radius > 0 ? hz.radius : HAZARD_FENCE_M);
+    }
   }
 }
@@ -1,36 +1,13 @@
 #pragma once
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
-#include <vector>
+#include <esp_partition.h>
 #include <functional>
-
-// —— Data types ——
-struct Geo {
-  double lat;
-  double lon;
-};
-
-struct Hazard {
-  String type;
-  Geo loc;
-};
-
-// CoursesManager.h
-struct Hole {
-  int   number;
-  int   par;            // ← add this
-  Geo   pin;
-  Geo   front;
-  Geo   back;
-  std::vector<Hazard> hazards;
-};
-
-struct Course {
-  String name;
-  Geo location;
-  std::vector<Hole> holes;
-};
+#include "Arena.h"
+#include "CourseImage.h"
+#include "CourseTypes.h"
+#include "Geo.h"
+#include "Geofence.h"
 
 class CoursesManager {
 public:
@@ -39,13 +16,31 @@ public:
     return inst;
   }
 
-  /// Load from the `coursesJson` PROGMEM string
+  /// Map the course image in the "courses" flash partition (written from
+  /// tools/course_compiler --image), or, when it holds none, use the one
+  /// built into the firmware (courses_db.h).  Nothing is parsed or copied.
   void beginFromFlash();
 
-  const std::vector<Course>& getCourses() const {
-    return courses_;
+  /// Courses in the image, in name order.
+  size_t courseCount() const { return image_.size(); }
+  const char* courseName(size_t i) const { return image_.name(i); }
+  Geo courseLocation(size_t i) const { return image_.location(i); }
+
+  /// Course `i`, decoded from the image when it differs from the last one
+  /// asked for.  Its holes and hazards live in one arena that the next
+  /// course reuses, so the reference is only good until another course is
+  /// requested.
+  const Course& course(size_t i);
+
+  /// Up to `k` course indices nearest `from`, closest first.
+  size_t nearest(const Geo& from, size_t k, uint32_t* out) const {
+    return image_.nearest(from, k, out);
   }
 
+  /// Replace `g`'s fences with course `idx`'s boundary, tees, greens and
+  /// hazards, in the course frame.
+  void buildFences(size_t idx, GeofenceEngine& g);
+
   /// Optional callback when done loading
   void setLoadedCallback(std::function<void()> cb) {
     onLoaded_ = cb;
@@ -54,9 +49,12 @@ public:
 private:
   CoursesManager() = default;
 
-  /// Break out the JSON-to-object parsing
-  void parseCourses(JsonArray arr);
+  CourseImage image_;
+  esp_partition_mmap_handle_t map_ = 0;
 
-  std::vector<Course> courses_;
+  // the decoded course
+  Course course_{};
+  size_t courseIdx_ = SIZE_MAX;
+  Arena  arena_;      // sized once for the image's largest course
   std::function<void()> onLoaded_;
 };
@@ -4,46 +4,26 @@
 #include "Layout.h"
 #include <Arduino.h>
 #include "HolePage.h"
-#include <cmath>
 #include <numeric>
 
-// haversine helper
-static constexpr double R_earth = 6'371'000.0;
-static double haversine(double lat1, double lon1,
-                        double lat2, double lon2) {
-  auto toRad = [](double d) {
-    return d * M_PI / 180.0;
-  };
-  double dlat = toRad(lat2 - lat1), dlon = toRad(lon2 - lon1);
-  double a = sin(dlat / 2) * sin(dlat / 2)
-             + cos(toRad(lat1)) * cos(toRad(lat2))
-                 * sin(dlon / 2) * sin(dlon / 2);
-  return R_earth * 2 * atan2(sqrt(a), sqrt(1 - a));
-}
-
 static constexpr int BTN_H = 80;
+static constexpr size_t NEAREST_SHOWN = 20;
 
 void CoursesPage::onCreate() {
   createBase("Courses", true);
 
-  // fetch & sort
-  auto& courses = CoursesManager::instance().getCourses();
-  std::vector<int> idx(courses.size());
-  std::iota(idx.begin(), idx.end(), 0);
+  // with a fix, just the nearest few; otherwise everything by name (the
+  // image is already in name order)
+  auto& courses = CoursesManager::instance();
+  std::vector<int> idx;
   auto gps = GpsManager::instance().fetchData();
   if (gps.fix) {
-    std::sort(idx.begin(), idx.end(), [&](int a, int b) {
-      double da = std::pow(courses[a].location.lat - gps.lat, 2)
-                  + std::pow(courses[a].location.lon - gps.lon, 2);
-      double db = std::pow(courses[b].location.lat - gps.lat, 2)
-                  + std::pow(courses[b].location.lon - gps.lon, 2);
-      return da < db;
-    });
+    uint32_t near[NEAREST_SHOWN];
+    size_t n = courses.nearest(gps.pos, NEAREST_SHOWN, near);
+    idx.assign(near, near + n);
   } else {
-    std::sort(idx.begin(), idx.end(),
-              [&](int a, int b) {
-                return courses[a].name < courses[b].name;
-              });
+    idx.resize(courses.courseCount());
+    std::iota(idx.begin(), idx.end(), 0);
   }
 
   // button style
@@ -67,7 +47,7 @@ void CoursesPage::onCreate() {
 
     // name
     auto nm = lv_label_create(btn);
-    lv_label_set_text(nm, courses[ci].name.c_str());
+    lv_label_set_text(nm, courses.courseName(ci));
     lv_obj_set_style_text_font(nm, &lv_font_montserrat_32, LV_PART_MAIN);
     lv_obj_set_style_text_color(nm, lv_color_black(), LV_PART_MAIN);
     lv_obj_align(nm, LV_ALIGN_LEFT_MID, 16, 0);
@@ -123,16 +103,15 @@ void CoursesPage::onGpsUpdate(const GpsData& d) {
 }
 
 void CoursesPage::updateLabels(const GpsData& d) {
-  auto& courses = CoursesManager::instance().getCourses();
+  auto& courses = CoursesManager::instance();
   for (size_t i = 0; i < btns_.size(); ++i) {
+    // rows scrolled out of view keep their last text
+    if (!lv_obj_is_visible(btns_[i])) continue;
     int ci = (int)(intptr_t)lv_obj_get_user_data(btns_[i]);
     if (d.fix) {
-      double m = haversine(
-        d.lat, d.lon,
-        courses[ci].location.lat,
-        courses[ci].location.lon);
+      float m = geo::distance(d.pos, courses.courseLocation(ci));
       char buf[16];
-      if (m >= 1000) snprintf(buf, sizeof(buf), "%.1f km", m / 1000.0);
+      if (m >= 1000) snprintf(buf, sizeof(buf), "%.1f km", m / 1000.0f);
       else snprintf(buf, sizeof(buf), "%.0f m", m);
       lv_label_set_text(lblDist_[i], buf);
       lv_obj_clear_flag(lblDist_[i], LV_OBJ_FLAG_HIDDEN);
@@ -0,0 +1,34 @@
+#include "EpochAssembler.h"
+
+bool EpochAssembler::add(const NmeaParser& p, NmeaParser::Sentence s) {
+  uint8_t part = s == NmeaParser::Sentence::GGA ? GPS_PART_GGA
+               : s == NmeaParser::Sentence::RMC ? GPS_PART_RMC
+               : 0;
+  if (!part) return false;
+
+  bool published = false;
+  uint32_t key = p.utcKey();
+
+  // a new timestamp (or a repeat of a part) closes the open epoch
+  if (parts_ && (key != key_ || (parts_ & part))) {
+    finish();
+    published = true;
+  }
+
+  key_ = key;
+  p.apply(pending_);
+  parts_ |= part;
+
+  if (parts_ == GPS_PART_ALL) {
+    finish();
+    published = true;
+  }
+  return published;
+}
+
+void EpochAssembler::finish() {
+  pending_.seq   = ++seq_;
+  pending_.parts = parts_;
+  done_  = pending_;
+  parts_ = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+#include "GpsData.h"
+#include "NmeaParser.h"
+
+/// Folds the GGA and RMC of one receiver epoch into a single fix.
+///
+/// Sentences are keyed on their UTC timestamp.  A fix is published as soon
+/// as every part has arrived, or — if a part went missing — when the next
+/// epoch starts, with `parts` saying what it holds.  Either way readers see
+/// position, speed and quality from the same instant, once per epoch.
+class EpochAssembler {
+public:
+  /// Fold in the sentence `p` just accepted.  Returns true when latest()
+  /// holds a newly finished epoch.
+  bool add(const NmeaParser& p, NmeaParser::Sentence s);
+
+  /// Last finished epoch.
+  const GpsData& latest() const { return done_; }
+
+private:
+  void finish();
+
+  GpsData  pending_;
+  GpsData  done_;
+  uint32_t key_   = 0;
+  uint8_t  parts_ = 0;
+  uint32_t seq_   = 0;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/// Single-precision sin / cos / atan2 / sqrt, picked by error bound at
+/// compile time.
+///
+/// The ESP32-S3 FPU does float only; newlib's atan2f and sinf are generic
+/// and slow, so the hot paths call these instead.  sin/cos are a constexpr
+/// table (built by the compiler, placed in flash) plus a short polynomial
+/// on the remainder; atan2 is octant reduction plus a minimax polynomial.
+///
+/// Worst cases from tools/fastmath_sweep, which walks every float input
+/// (sin/cos over |x| < 16 rad):
+///
+///   tier   sin/cos abs   atan2 abs (rad)   sqrt rel
+///   Low    4.8e-3        3.8e-3            1.8e-3
+///   Mid    2.1e-5        1.2e-5            4.8e-6
+///   High   1.6e-6        2.9e-7            sqrtf
+///
+/// The High sin/cos error is mostly float rounding in the argument
+/// reduction, so it grows with |x|: under 9e-7 below 12.5 rad, which
+/// covers every angle the firmware passes, and 1.6e-6 above.
+///
+/// Use `fm::sin<fm::Tier::Mid>(x)`, or let the bound choose:
+/// `fm::sin<fm::tierFor(1e-4)>(x)`.
+namespace fm {
+
+enum class Tier : uint8_t { Low, Mid, High };
+
+/// Cheapest tier whose worst-case error (all four kernels) is within `err`.
+constexpr Tier tierFor(double err) {
+  return err >= 5e-3 ? Tier::Low : err >= 3e-5 ? Tier::Mid : Tier::High;
+}
+
+// Arduino.h owns the PI / HALF_PI macros
+static constexpr float PI_F      = 3.14159265358979f;
+static constexpr float HALF_PI_F = 1.57079632679490f;
+
+namespace detail {
+
+// Taylor series, used only at compile time to fill the tables
+constexpr double sinSeries(double x) {
+  double term = x, sum = x;
+  for (int n = 1; n < 24; ++n) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+/// sin at N + N/4 + 1 steps over [0, 2.5 pi], so cos is a quarter-turn
+/// offset into the same table and the interpolation never wraps.
+template <size_t N>
+struct SinTable {
+  static_assert(N && (N & (N - 1)) == 0, "table size must be a power of two");
+  static constexpr double PI_D = 3.14159265358979323846;
+  float v[N + N / 4 + 1] = {};
+  constexpr SinTable() {
+    for (size_t k = 0; k <= N + N / 4; ++k) {
+      // reduce to [-pi, pi] so the series converges quickly
+      double a = 2.0 * PI_D * double(k % N) / N;
+      v[k] = float(sinSeries(a > PI_D ? a - 2.0 * PI_D : a));
+    }
+  }
+};
+
+template <Tier T> struct SinCfg;
+template <> struct SinCfg<Tier::Low>  { static constexpr size_t N = 32;  };
+template <> struct SinCfg<Tier::Mid>  { static constexpr size_t N = 64;  };
+template <> struct SinCfg<Tier::High> { static constexpr size_t N = 256; };
+
+template <Tier T>
+struct Table {
+  static constexpr size_t N = SinCfg<T>::N;
+  static constexpr SinTable<N> sin{};
+};
+
+// sin(x + quarter turns); `quarter` is 0 for sin, 1 for cos
+template <Tier T>
+inline float sinOffset(float x, size_t quarter) {
+  constexpr size_t N = Table<T>::N;
+  constexpr float STEPS_PER_RAD = float(N / (2.0 * 3.14159265358979323846));
+  constexpr float RAD_PER_STEP  = float(2.0 * 3.14159265358979323846 / N);
+
+  // nearest table entry, so |r| is at most half a step
+  float f = x * STEPS_PER_RAD + 0.5f;
+  int32_t k = int32_t(f);
+  if (f < float(k)) --k;                       // floor for negative angles
+  float r = (f - 0.5f - float(k)) * RAD_PER_STEP;
+  size_t i = (size_t(k) + quarter * (N / 4)) & (N - 1);
+
+  const float* t = Table<T>::sin.v;
+  float s = t[i], c = t[i + N / 4];
+  // sin(a + r) = sin a cos r + cos a sin r, with r under half a step
+  if (T == Tier::Low) return s + c * r;
+  float r2 = r * r;
+  if (T == Tier::Mid) return s * (1.0f - 0.5f * r2) + c * r;
+  return s * (1.0f - r2 * (0.5f - r2 * (1.0f / 24)))
+       + c * r * (1.0f - r2 * (1.0f / 6));
+}
+
+// atan on [0, 1]
+template <Tier T>
+inline float atanUnit(float z) {
+  if (T == Tier::Low)
+    return z * (PI_F / 4 + 0.273f * (1.0f - z));
+  if (T == Tier::Mid) {
+    float z2 = z * z;
+    return z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f
+             + z2 * (-0.0851330f + z2 * 0.0208351f))));
+  }
+  // above tan(15 deg), rotate by 30 deg so the series argument stays small
+  constexpr float TAN15 = 0.26794919f, SQRT3 = 1.73205081f;
+  float base = 0.0f;
+  if (z > TAN15) {
+    z = (z * SQRT3 - 1.0f) / (z + SQRT3);
+    base = PI_F / 6;
+  }
+  float z2 = z * z;
+  return base + z * (1.0f + z2 * (-1.0f / 3 + z2 * (1.0f / 5 + z2 * (-1.0f / 7
+              + z2 * (1.0f / 9 + z2 * (-1.0f / 11))))));
+}
+
+}  // namespace detail
+
+template <Tier T> inline float sin(float x) { return detail::sinOffset<T>(x, 0); }
+template <Tier T> inline float cos(float x) { return detail::sinOffset<T>(x, 1); }
+
+/// Angle of (x, y) in (-pi, pi], like atan2f.
+template <Tier T>
+inline float atan2(float y, float x) {
+  float ax = fabsf(x), ay = fabsf(y);
+  float hi = ax > ay ? ax : ay;
+  if (hi == 0.0f) return 0.0f;
+  float lo = ax > ay ? ay : ax;
+  float a = detail::atanUnit<T>(lo / hi);
+  if (ay > ax) a = HALF_PI_F - a;
+  if (x < 0.0f) a = PI_F - a;
+  return y < 0.0f ? -a : a;
+}
+
+template <Tier T>
+inline float sqrt(float x) {
+  if (T == Tier::High || x <= 0.0f) return sqrtf(x);
+  // reciprocal square root from the exponent bits, then Newton steps
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  bits = 0x5F375A86u - (bits >> 1);
+  float y;
+  memcpy(&y, &bits, sizeof(y));
+  y *= 1.5f - 0.5f * x * y * y;
+  if (T == Tier::Mid) y *= 1.5f - 0.5f * x * y * y;
+  return x * y;
+}
+
+}  // namespace fm
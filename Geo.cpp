@@ -0,0 +1,80 @@
+#include "Geo.h"
+#include <math.h>
+#include "FastMath.h"
+
+namespace geo {
+
+static constexpr float R_EARTH    = 6'371'000.0f;
+static constexpr float RAD_PER_E7 = float(M_PI / 180.0 / E7);
+static constexpr int64_t HALF_TURN = 1'800'000'000;
+
+// Beyond ~11 km the flat-offset approximation drifts past a metre; switch
+// to haversine (still single precision) for those.
+static constexpr int32_t FLAT_LIMIT_E7 = 1'000'000;
+
+int32_t deltaLon(int32_t a, int32_t b) {
+  int64_t d = int64_t(b) - a;
+  if (d >  HALF_TURN) d -= 2 * HALF_TURN;
+  if (d <= -HALF_TURN) d += 2 * HALF_TURN;
+  return int32_t(d);
+}
+
+float distance(const Geo& a, const Geo& b) {
+  int32_t dLat = b.lat - a.lat;
+  int32_t dLon = deltaLon(a.lon, b.lon);
+
+  if (dLat > -FLAT_LIMIT_E7 && dLat < FLAT_LIMIT_E7 &&
+      dLon > -FLAT_LIMIT_E7 && dLon < FLAT_LIMIT_E7) {
+    // equirectangular about the mid-latitude; deltas are exact in float
+    float midLat = (a.lat + dLat / 2) * RAD_PER_E7;
+    float x = dLon * RAD_PER_E7 * fm::cos<fm::Tier::High>(midLat);
+    float y = dLat * RAD_PER_E7;
+    return R_EARTH * sqrtf(x * x + y * y);
+  }
+
+  using fm::Tier;
+  float sLat = fm::sin<Tier::High>(dLat * RAD_PER_E7 * 0.5f);
+  float sLon = fm::sin<Tier::High>(dLon * RAD_PER_E7 * 0.5f);
+  float h = sLat * sLat
+          + fm::cos<Tier::High>(a.lat * RAD_PER_E7)
+          * fm::cos<Tier::High>(b.lat * RAD_PER_E7) * sLon * sLon;
+  h = fminf(h, 1.0f);
+  // 2 asin(sqrt h), as an atan2 so one kernel covers it
+  return R_EARTH * 2.0f * fm::atan2<Tier::High>(sqrtf(h), sqrtf(1.0f - h));
+}
+
+// WGS84 ellipsoid
+static constexpr double WGS84_A  = 6378137.0;
+static constexpr double WGS84_F  = 1.0 / 298.257223563;
+static constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);
+
+LocalFrame::LocalFrame(const Geo& origin, Earth earth)
+  : origin_(origin), earth_(earth) {
+  // once per course, so double and libm are fine here
+  const double radPerE7 = M_PI / 180.0 / E7;
+  double lat = origin.lat * radPerE7;
+  double s = sin(lat), c = cos(lat);
+
+  // meridian (M) and prime-vertical (N) radii of curvature, and how the
+  // east scale N cos(lat) and north scale M move with latitude
+  double M = R_EARTH, N = R_EARTH, dM = 0.0;
+  if (earth == Earth::Wgs84) {
+    double w = 1.0 - WGS84_E2 * s * s;
+    N  = WGS84_A / sqrt(w);
+    M  = WGS84_A * (1.0 - WGS84_E2) / (w * sqrt(w));
+    dM = 3.0 * M * WGS84_E2 * s * c / w;
+  }
+  mPerE7Lat_ = float(M * radPerE7);
+  mPerE7Lon_ = float(N * c * radPerE7);
+
+  // d(N cos)/dlat = -M sin, per metre north (one metre is 1/M rad)
+  xSlope_ = float(-s / (N * c));
+  ySlope_ = float(dM / (M * M));
+}
+
+Geo LocalFrame::toGeo(const Vec2& v) const {
+  return Geo{ origin_.lat + int32_t(lroundf(v.y / mPerE7Lat_)),
+              origin_.lon + int32_t(lroundf(v.x / mPerE7Lon_)) };
+}
+
+}  // namespace geo
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+/// Geographic position in fixed point, degrees * 1e7.  One unit is about
+/// 1.1 cm of latitude, and deltas between any two points fit in int32, so
+/// the hot paths never touch double precision.
+struct Geo {
+  int32_t lat = 0;
+  int32_t lon = 0;
+};
+
+namespace geo {
+
+static constexpr double E7 = 1e7;
+
+/// Round decimal degrees (course data, printing) to fixed point.
+inline int32_t toE7(double deg) {
+  return int32_t(deg * E7 + (deg < 0 ? -0.5 : 0.5));
+}
+
+inline double toDegrees(int32_t e7) {
+  return e7 / E7;
+}
+
+inline Geo fromDegrees(double lat, double lon) {
+  return Geo{ toE7(lat), toE7(lon) };
+}
+
+/// Longitude difference b - a, wrapped into (-180°, 180°].
+int32_t deltaLon(int32_t a, int32_t b);
+
+/// Great-circle distance in metres on a 6371 km sphere.  The deltas are
+/// taken in integers; only the resulting local offset is handled in float.
+float distance(const Geo& a, const Geo& b);
+
+/// Metres east (x) / north (y) of a LocalFrame origin.
+struct Vec2 {
+  float x = 0.0f;
+  float y = 0.0f;
+};
+
+inline float distance(const Vec2& a, const Vec2& b) {
+  float dx = b.x - a.x, dy = b.y - a.y;
+  return sqrtf(dx * dx + dy * dy);
+}
+
+/// Earth model behind a LocalFrame's scale factors.
+enum class Earth : uint8_t {
+  Sphere,   // 6371 km, matching geo::distance()
+  Wgs84,    // ellipsoid: meridian and prime-vertical radii at the origin
+};
+
+/// Equirectangular east/north frame about a fixed origin, one per course.
+///
+/// The origin's metres-per-unit are cached, so projecting a point is two
+/// integer subtractions and two multiplies.  Projected coordinates carry
+/// the origin's scale; delta() / distance() rescale an offset to its
+/// pair's mid-latitude with one precomputed slope per axis, which takes
+/// the error from about tan(lat0) * r / R (2.3e-4 at 26° S, r = 3 km) down
+/// to second order, well under a centimetre on a course.  With Earth::Wgs84
+/// the scales are the ellipsoid's own, M(lat) and N(lat) cos(lat), so the
+/// result tracks the WGS84 geodesic rather than the sphere, which is off
+/// by up to 0.5%.
+class LocalFrame {
+public:
+  LocalFrame() = default;
+  explicit LocalFrame(const Geo& origin, Earth earth = Earth::Sphere);
+
+  /// A frame computed ahead of time (e.g. by the course compiler) from
+  /// another frame's scales and slopes.
+  constexpr LocalFrame(const Geo& origin, Earth earth, float mPerE7Lat,
+                       float mPerE7Lon, float xSlope, float ySlope)
+    : origin_(origin), earth_(earth), mPerE7Lat_(mPerE7Lat),
+      mPerE7Lon_(mPerE7Lon), xSlope_(xSlope), ySlope_(ySlope) {}
+
+  const Geo& origin() const { return origin_; }
+  Earth earth() const { return earth_; }
+
+  Vec2 toLocal(const Geo& g) const {
+    return Vec2{ float(deltaLon(origin_.lon, g.lon)) * mPerE7Lon_,
+                 float(g.lat - origin_.lat) * mPerE7Lat_ };
+  }
+
+  Geo toGeo(const Vec2& v) const;
+
+  /// b - a in true metres: each axis scaled by 1 + slope * mid-northing.
+  Vec2 delta(const Vec2& a, const Vec2& b) const {
+    float m = 0.5f * (a.y + b.y);
+    return Vec2{ (b.x - a.x) * (1.0f + xSlope_ * m),
+                 (b.y - a.y) * (1.0f + ySlope_ * m) };
+  }
+
+  float distance(const Vec2& a, const Vec2& b) const {
+    Vec2 d = delta(a, b);
+    return sqrtf(d.x * d.x + d.y * d.y);
+  }
+
+  float distance(const Geo& a, const Geo& b) const {
+    return distance(toLocal(a), toLocal(b));
+  }
+
+  /// Relative change of the east / north scale per metre north of the
+  /// origin; for batch code that applies delta() itself.
+  float xSlope() const { return xSlope_; }
+  float ySlope() const { return ySlope_; }
+
+  /// Metres per 1e-7 degree of latitude / longitude at the origin.
+  float mPerE7Lat() const { return mPerE7Lat_; }
+  float mPerE7Lon() const { return mPerE7Lon_; }
+
+private:
+  Geo   origin_;
+  Earth earth_     = Earth::Sphere;
+  float mPerE7Lat_ = 0.0f;
+  float mPerE7Lon_ = 0.0f;
+  float xSlope_    = 0.0f;
+  float ySlope_    = 0.0f;
+};
+
+}  // namespace geo
@@ -0,0 +1,168 @@
+#include "Geofence.h"
+#include <math.h>
+
+static float length(float x, float y) { return sqrtf(x * x + y * y); }
+
+void GeofenceEngine::clear() {
+  fences_.clear();
+  points_.clear();
+  margin_ = -1.0f;
+}
+
+int GeofenceEngine::addCircle(FenceKind kind, uint8_t hole, uint8_t ref,
+                              const geo::Vec2& centre, float radius) {
+  Fence f;
+  f.kind   = kind;
+  f.hole   = hole;
+  f.ref    = ref;
+  f.centre = centre;
+  f.radius = radius;
+  f.x0 = centre.x - radius;  f.x1 = centre.x + radius;
+  f.y0 = centre.y - radius;  f.y1 = centre.y + radius;
+  fences_.push_back(f);
+  margin_ = -1.0f;
+  return int(fences_.size() - 1);
+}
+
+int GeofenceEngine::addPolygon(FenceKind kind, uint8_t hole, uint8_t ref,
+                               const geo::Vec2* pts, size_t n) {
+  if (n < 3) return -1;
+  Fence f;
+  f.kind  = kind;
+  f.hole  = hole;
+  f.ref   = ref;
+  f.first = uint32_t(points_.size());
+  f.count = uint32_t(n);
+  f.x0 = f.x1 = pts[0].x;
+  f.y0 = f.y1 = pts[0].y;
+  for (size_t i = 0; i < n; ++i) {
+    points_.push_back(pts[i]);
+    f.x0 = fminf(f.x0, pts[i].x);  f.x1 = fmaxf(f.x1, pts[i].x);
+    f.y0 = fminf(f.y0, pts[i].y);  f.y1 = fmaxf(f.y1, pts[i].y);
+  }
+  fences_.push_back(f);
+  margin_ = -1.0f;
+  return int(fences_.size() - 1);
+}
+
+// crossing-number test, plus the distance to the nearest edge
+bool GeofenceEngine::insidePolygon(const Fence& f, const geo::Vec2& p,
+                                   float& edge) const {
+  const geo::Vec2* v = &points_[f.first];
+  bool in = false;
+  float best2 = INFINITY;
+  for (uint32_t i = 0, j = f.count - 1; i < f.count; j = i++) {
+    const geo::Vec2& a = v[j];
+    const geo::Vec2& b = v[i];
+    if ((b.y > p.y) != (a.y > p.y) &&
+        p.x < (a.x - b.x) * (p.y - b.y) / (a.y - b.y) + b.x)
+      in = !in;
+
+    float ex = a.x - b.x, ey = a.y - b.y;
+    float wx = p.x - b.x, wy = p.y - b.y;
+    float len2 = ex * ex + ey * ey;
+    float t = len2 > 0.0f ? (wx * ex + wy * ey) / len2 : 0.0f;
+    t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+    float dx = wx - t * ex, dy = wy - t * ey;
+    best2 = fminf(best2, dx * dx + dy * dy);
+  }
+  edge = sqrtf(best2);
+  return in;
+}
+
+void GeofenceEngine::test(Fence& f, const geo::Vec2& p) {
+  ++tests_;
+  bool in;
+  float margin;
+  if (f.count == 0) {
+    float d = length(p.x - f.centre.x, p.y - f.centre.y);
+    in     = d < f.radius;
+    margin = fabsf(d - f.radius);
+  } else if (p.x < f.x0 || p.x > f.x1 || p.y < f.y0 || p.y > f.y1) {
+    // outside the box: the box is never further than the outline
+    float dx = fmaxf(fmaxf(f.x0 - p.x, p.x - f.x1), 0.0f);
+    float dy = fmaxf(fmaxf(f.y0 - p.y, p.y - f.y1), 0.0f);
+    in     = false;
+    margin = length(dx, dy);
+  } else {
+    in = insidePolygon(f, p, margin);
+  }
+  f.anchor = p;
+  f.margin = margin;
+
+  if (in == f.inside) return;
+  f.inside = in;
+  pending_.push_back(
+    FenceEvent{ uint16_t(&f - fences_.data()), f.kind, f.hole, f.ref, in });
+}
+
+void GeofenceEngine::update(const geo::Vec2& p) {
+  // nothing can have been crossed within the smallest margin
+  if (margin_ >= 0.0f) {
+    float moved = length(p.x - last_.x, p.y - last_.y);
+    if (moved < margin_) {
+      margin_ -= moved;
+      last_ = p;
+      skipped_ += uint32_t(fences_.size());
+      return;
+    }
+  }
+
+  float margin = INFINITY;
+  for (Fence& f : fences_) {
+    float moved = f.margin >= 0.0f
+                ? length(p.x - f.anchor.x, p.y - f.anchor.y) : 0.0f;
+    if (f.margin >= 0.0f && moved < f.margin) {
+      ++skipped_;
+      margin = fminf(margin, f.margin - moved);
+      continue;
+    }
+    test(f, p);
+    margin = fminf(margin, f.margin);
+  }
+  last_   = p;
+  margin_ = fences_.empty() ? -1.0f : margin;
+
+  // after the walk, so a subscriber may rebuild the fences
+  std::vector<FenceEvent> events;
+  events.swap(pending_);
+  if (events.empty()) return;
+
+  // a subscriber may (un)subscribe from its callback: the vector holds
+  // still until the last event is out, then drops the dead and takes the new
+  dispatching_ = true;
+  for (const FenceEvent& e : events)
+    for (size_t i = 0; i < subs_.size(); ++i)
+      if (subs_[i].first) subs_[i].second(e);
+  dispatching_ = false;
+
+  size_t n = 0;
+  for (size_t i = 0; i < subs_.size(); ++i)
+    if (subs_[i].first) {
+      if (n != i) subs_[n] = std::move(subs_[i]);
+      ++n;
+    }
+  subs_.resize(n);
+  for (auto& s : added_) subs_.push_back(std::move(s));
+  added_.clear();
+}
+
+int GeofenceEngine::subscribe(Callback cb) {
+  (dispatching_ ? added_ : subs_).emplace_back(nextToken_, std::move(cb));
+  return nextToken_++;
+}
+
+void GeofenceEngine::unsubscribe(int token) {
+  for (size_t i = 0; i < added_.size(); ++i) {
+    if (added_[i].first != token) continue;
+    added_.erase(added_.begin() + i);
+    return;
+  }
+  for (size_t i = 0; i < subs_.size(); ++i) {
+    if (subs_[i].first != token) continue;
+    // mid-dispatch the callback may be the one running; token 0 marks it
+    if (dispatching_) subs_[i].first = 0;
+    else subs_.erase(subs_.begin() + i);
+    return;
+  }
+}
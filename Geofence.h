@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "Geo.h"
+
+enum class FenceKind : uint8_t { Boundary, Tee, Green, Hazard };
+
+/// Crossing of one fence, delivered to every subscriber.
+struct FenceEvent {
+  uint16_t  fence;     // id returned by add*()
+  FenceKind kind;
+  uint8_t   hole;      // index into Course::holes
+  uint8_t   ref;       // e.g. hazard index
+  bool      entered;   // false: exited
+};
+
+/// Enter / exit events for circles and polygons in a course's local frame.
+///
+/// Each fence remembers the point it was last tested at and how far that
+/// point was from its edge; until the player moves further than that it
+/// cannot have been crossed and is not tested again.  The engine keeps
+/// the smallest such margin across all fences too, so a fix that moves
+/// less than it costs one distance check however many fences there are.
+/// Polygons are only walked when the player is inside their bounding box;
+/// outside it the box distance serves as the margin.
+class GeofenceEngine {
+public:
+  using Callback = std::function<void(const FenceEvent&)>;
+
+  static GeofenceEngine& instance() {
+    static GeofenceEngine inst;
+    return inst;
+  }
+
+  /// Drop every fence (subscribers stay); no exit events are sent.
+  void clear();
+
+  /// The frame update(Geo) projects through; fences are given in it.
+  void setFrame(const geo::LocalFrame& frame) { frame_ = frame; }
+
+  int addCircle(FenceKind kind, uint8_t hole, uint8_t ref,
+                const geo::Vec2& centre, float radius);
+
+  /// Closed outline of `n` vertices, either winding.
+  int addPolygon(FenceKind kind, uint8_t hole, uint8_t ref,
+                 const geo::Vec2* pts, size_t n);
+
+  /// Feed one fix.  Fences the player is already in when first seen
+  /// report an enter.
+  void update(const Geo& pos) { update(frame_.toLocal(pos)); }
+  void update(const geo::Vec2& p);
+
+  /// Both are safe from inside a callback: an unsubscribed callback gets
+  /// nothing further, a new one starts with the next update().
+  int  subscribe(Callback cb);
+  void unsubscribe(int token);
+
+  size_t size() const { return fences_.size(); }
+
+  /// Fence tests actually run vs. skipped on their margin.
+  uint32_t tests()   const { return tests_; }
+  uint32_t skipped() const { return skipped_; }
+
+private:
+  struct Fence {
+    FenceKind kind;
+    uint8_t   hole, ref;
+    bool      inside = false;
+    // circle when `count` is 0, else points_[first, first + count)
+    uint32_t  first = 0, count = 0;
+    geo::Vec2 centre;
+    float     radius = 0.0f;
+    float     x0, y0, x1, y1;        // bounding box
+    geo::Vec2 anchor;                // where it was last tested
+    float     margin = -1.0f;        // distance to edge from there
+  };
+
+  void test(Fence& f, const geo::Vec2& p);
+  bool insidePolygon(const Fence& f, const geo::Vec2& p, float& edge) const;
+
+  geo::LocalFrame        frame_;
+  std::vector<Fence>     fences_;
+  std::vector<geo::Vec2> points_;
+  std::vector<FenceEvent> pending_;
+  std::vector<std::pair<int, Callback>> subs_;    // token 0: unsubscribed
+  std::vector<std::pair<int, Callback>> added_;   // during dispatch
+  int       nextToken_ = 1;
+  bool      dispatching_ = false;
+
+  geo::Vec2 last_;
+  float     margin_   = -1.0f;       // all fences safe within this of last_
+  uint32_t  tests_    = 0;
+  uint32_t  skipped_  = 0;
+};
@@ -0,0 +1,242 @@
+#include "GpsAiding.h"
+#include <Preferences.h>
+#include <SD_MMC.h>
+#include <sys/time.h>
+#include <time.h>
+
+static constexpr const char* NVS_NS = "gps";
+static constexpr uint8_t TTFF_LOG_LEN = 8;
+
+// MTK EPO: 32 SVs x 60 bytes per 6-hour set, uploaded 3 SVs per packet
+static constexpr size_t   EPO_SV_BYTES   = 60;
+static constexpr size_t   EPO_SET_SVS    = 32;
+static constexpr size_t   EPO_SET_BYTES  = EPO_SV_BYTES * EPO_SET_SVS;
+static constexpr uint16_t BIN_EPO_DATA   = 722;
+static constexpr uint16_t BIN_EPO_ACK    = 723;
+static constexpr uint16_t BIN_SET_NMEA   = 253;
+static constexpr uint32_t BIN_ACK_MS     = 1000;
+
+// GPS epoch (1980-01-06) as Unix time, and the current GPS-UTC offset
+static constexpr time_t   GPS_EPOCH_UNIX = 315964800;
+static constexpr time_t   GPS_LEAP_S     = 18;
+static constexpr time_t   VALID_AFTER    = 1700000000;  // clock was set
+
+struct TtffLog {
+  uint8_t  next = 0;
+  uint8_t  flags[TTFF_LOG_LEN] = {};
+  uint32_t ms[TTFF_LOG_LEN]    = {};
+};
+
+// days since 1970-01-01 for a proleptic Gregorian date
+static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+  y -= m <= 2;
+  int32_t era = (y >= 0 ? y : y - 399) / 400;
+  uint32_t yoe = uint32_t(y - era * 400);
+  uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + int32_t(doe) - 719468;
+}
+
+void GpsAiding::begin() {
+  if (!task_) xTaskCreate(writerTask, "gpsaid", 4096, this, 1, &task_);
+}
+
+bool GpsAiding::load(Record& r) {
+  Preferences p;
+  p.begin(NVS_NS, true);
+  bool ok = p.getBytes("last", &r, sizeof(r)) == sizeof(r);
+  p.end();
+  return ok;
+}
+
+bool GpsAiding::clockTime(pmtk::UtcTime& t) const {
+  time_t now = time(nullptr);
+  if (now < VALID_AFTER) return false;
+  struct tm tm;
+  gmtime_r(&now, &tm);
+  t = { uint16_t(tm.tm_year + 1900), uint8_t(tm.tm_mon + 1),
+        uint8_t(tm.tm_mday), uint8_t(tm.tm_hour),
+        uint8_t(tm.tm_min), uint8_t(tm.tm_sec) };
+  return true;
+}
+
+void GpsAiding::onFix(const GpsData& d) {
+  if (!d.fix || !d.year || !(d.parts & GPS_PART_RMC)) return;
+
+  if (!clockSet_) {
+    timeval tv = {};
+    tv.tv_sec = time_t(daysFromCivil(d.year, d.month, d.day)) * 86400
+              + d.hour * 3600 + d.minute * 60 + d.second;
+    tv.tv_usec = d.millis * 1000;
+    settimeofday(&tv, nullptr);
+    clockSet_ = true;
+  }
+
+  if (d.hdop > SAVE_MAX_HDOP || !task_) return;
+  if (saved_ && millis() - lastSaveMs_ < SAVE_INTERVAL_MS) return;
+  // writer still busy with the last one: try again next fix
+  if (fixPending_.load(std::memory_order_acquire)) return;
+
+  Record& r    = pendingFix_;
+  r.pos        = d.pos;
+  r.altitude   = int16_t(d.altitude);
+  r.fixQuality = d.fixQuality;
+  r.utc        = { d.year, d.month, d.day, d.hour, d.minute, d.second };
+  fixPending_.store(true, std::memory_order_release);
+  xTaskNotifyGive(task_);
+  saved_      = true;
+  lastSaveMs_ = millis();
+}
+
+void GpsAiding::logTtff(uint32_t ms, uint8_t flags) {
+  if (!task_ || !ms) return;
+  ttffFlags_ = flags;
+  ttffMs_.store(ms, std::memory_order_release);
+  xTaskNotifyGive(task_);
+}
+
+void GpsAiding::writerTask(void* arg) {
+  auto self = static_cast<GpsAiding*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    if (self->fixPending_.load(std::memory_order_acquire)) {
+      Record r = self->pendingFix_;
+      self->fixPending_.store(false, std::memory_order_release);
+      self->saveFix(r);
+    }
+    uint32_t ms = self->ttffMs_.exchange(0, std::memory_order_acquire);
+    if (ms) self->saveTtff(ms, self->ttffFlags_);
+  }
+}
+
+void GpsAiding::saveFix(const Record& r) {
+  Preferences p;
+  p.begin(NVS_NS, false);
+  p.putBytes("last", &r, sizeof(r));
+  p.end();
+}
+
+// MTK binary packet: 04 24 | len | cmd | data | xor | 0D 0A
+static void sendBinary(HardwareSerial& port, uint16_t cmd,
+                       const uint8_t* data, uint16_t n) {
+  uint8_t hdr[6] = { 0x04, 0x24,
+                     uint8_t(n + 9), uint8_t((n + 9) >> 8),
+                     uint8_t(cmd), uint8_t(cmd >> 8) };
+  uint8_t sum = 0;
+  for (int i = 2; i < 6; ++i) sum ^= hdr[i];
+  for (uint16_t i = 0; i < n; ++i) sum ^= data[i];
+  const uint8_t tail[3] = { sum, 0x0D, 0x0A };
+  port.write(hdr, sizeof(hdr));
+  port.write(data, n);
+  port.write(tail, sizeof(tail));
+}
+
+// Wait for the EPO ack (cmd 723: seq, result) for `seq`
+static bool waitEpoAck(HardwareSerial& port, uint16_t seq) {
+  uint8_t pkt[16];
+  size_t  got = 0;
+  uint32_t t0 = millis();
+  while (millis() - t0 < BIN_ACK_MS) {
+    if (!port.available()) { delay(1); continue; }
+    uint8_t c = port.read();
+    if (got == 0 && c != 0x04) continue;
+    if (got == 1 && c != 0x24) { got = 0; continue; }
+    pkt[got++] = c;
+    if (got < 4) continue;
+
+    size_t len = pkt[2] | pkt[3] << 8;
+    if (len > sizeof(pkt)) { got = 0; continue; }
+    if (got < len) continue;
+
+    uint16_t cmd = pkt[4] | pkt[5] << 8;
+    uint16_t ackSeq = pkt[6] | pkt[7] << 8;
+    if (cmd == BIN_EPO_ACK && ackSeq == seq) return pkt[8] == 1;
+    got = 0;
+  }
+  return false;
+}
+
+bool GpsAiding::uploadEpo(HardwareSerial& port, uint32_t baud,
+                          const char* path) {
+  fs::File f = SD_MMC.open(path);
+  if (!f) return false;
+  size_t sets = f.size() / EPO_SET_BYTES;
+  if (!sets) return false;
+
+  // GPS hour now, to skip sets that already expired (0 = unknown)
+  uint32_t gpsHourNow = 0;
+  time_t now = time(nullptr);
+  if (now >= VALID_AFTER)
+    gpsHourNow = uint32_t((now - GPS_EPOCH_UNIX + GPS_LEAP_S) / 3600);
+
+  char cmd[24];
+  pmtk::binaryMode(cmd, sizeof(cmd));
+  port.print(cmd);
+  port.print("\r\n");
+  port.flush();
+  delay(100);
+  while (port.available()) port.read();
+
+  uint8_t data[2 + 3 * EPO_SV_BYTES];
+  uint16_t seq = 0;
+  bool ok = true;
+
+  for (size_t s = 0; s < sets && ok; ++s) {
+    f.seek(s * EPO_SET_BYTES);
+    for (size_t sv = 0; sv < EPO_SET_SVS && ok; sv += 3) {
+      memset(data, 0, sizeof(data));
+      size_t n = (EPO_SET_SVS - sv < 3 ? EPO_SET_SVS - sv : 3) * EPO_SV_BYTES;
+      f.read(data + 2, n);
+
+      // each SV record starts with the 24-bit GPS hour of its set
+      if (sv == 0 && gpsHourNow) {
+        uint32_t hour = data[2] | data[3] << 8 | uint32_t(data[4]) << 16;
+        if (hour + 6 <= gpsHourNow) break;
+      }
+
+      data[0] = uint8_t(seq);
+      data[1] = uint8_t(seq >> 8);
+      sendBinary(port, BIN_EPO_DATA, data, sizeof(data));
+      ok = waitEpoAck(port, seq);
+      ++seq;
+    }
+  }
+  f.close();
+
+  // end-of-upload marker, then back to NMEA at the current baud
+  if (ok) {
+    memset(data, 0, sizeof(data));
+    data[0] = data[1] = 0xFF;
+    sendBinary(port, BIN_EPO_DATA, data, sizeof(data));
+    ok = waitEpoAck(port, 0xFFFF);
+  }
+  const uint8_t nmea[5] = { 0, uint8_t(baud), uint8_t(baud >> 8),
+                            uint8_t(baud >> 16), uint8_t(baud >> 24) };
+  sendBinary(port, BIN_SET_NMEA, nmea, sizeof(nmea));
+  port.flush();
+
+  Serial.printf("EPO: %s, %u packets%s\n", path, seq, ok ? "" : " (failed)");
+  return ok && seq > 0;
+}
+
+void GpsAiding::saveTtff(uint32_t ms, uint8_t flags) {
+  TtffLog log;
+  Preferences p;
+  p.begin(NVS_NS, false);
+  p.getBytes("ttff", &log, sizeof(log));
+  log.ms[log.next % TTFF_LOG_LEN]    = ms;
+  log.flags[log.next % TTFF_LOG_LEN] = flags;
+  log.next = (log.next + 1) % TTFF_LOG_LEN;
+  p.putBytes("ttff", &log, sizeof(log));
+  p.end();
+
+  Serial.println("TTFF, oldest boot first (t=time p=pos e=EPO):");
+  for (uint8_t i = 0; i < TTFF_LOG_LEN; ++i) {
+    uint8_t k = (log.next + i) % TTFF_LOG_LEN;
+    if (!log.ms[k]) continue;
+    Serial.printf("  %6.1f s  %c%c%c\n", log.ms[k] / 1000.0f,
+                  log.flags[k] & AIDED_TIME     ? 't' : '-',
+                  log.flags[k] & AIDED_POSITION ? 'p' : '-',
+                  log.flags[k] & AIDED_EPO      ? 'e' : '-');
+  }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <HardwareSerial.h>
+#include <atomic>
+#include "GpsData.h"
+#include "Pmtk.h"
+
+/// Hot-start aiding for the GPS receiver.
+///
+/// Keeps the last good fix in NVS (throttled), hands it back on the next
+/// boot as PMTK740/741, optionally uploads an MTK EPO ephemeris file from
+/// SD, and keeps a short NVS log of time-to-first-fix per boot so aided and
+/// unaided starts can be compared.
+///
+/// onFix() and logTtff() run on the GPS parser task, the only one draining
+/// the UART ring, so they only copy what is to be kept into a slot; an NVS
+/// commit can take tens of ms, and a low-priority task does the writing
+/// and printing.
+class GpsAiding {
+public:
+  static GpsAiding& instance() {
+    static GpsAiding inst;
+    return inst;
+  }
+
+  /// What a boot was helped with; stored alongside its TTFF.
+  enum : uint8_t {
+    AIDED_TIME     = 1 << 0,
+    AIDED_POSITION = 1 << 1,
+    AIDED_EPO      = 1 << 2,
+  };
+
+  struct Record {
+    Geo           pos;
+    int16_t       altitude   = 0;
+    uint8_t       fixQuality = 0;
+    pmtk::UtcTime utc        = {};
+  };
+
+  /// Start the writer task; onFix() and logTtff() keep nothing before.
+  void begin();
+
+  /// Last stored fix; false if NVS holds none.
+  bool load(Record& r);
+
+  /// Current UTC from the system clock.  Only valid if the clock was set
+  /// from a fix and survived the reset (soft reset, deep sleep).
+  bool clockTime(pmtk::UtcTime& t) const;
+
+  /// Called for every published epoch: sets the system clock on the first
+  /// dated fix and hands a good fix to the writer at most every
+  /// SAVE_INTERVAL_MS.  Never waits on NVS.
+  void onFix(const GpsData& d);
+
+  /// Upload an MTK EPO file over the binary protocol, skipping 6-hour sets
+  /// that have already expired when the clock is known.  The port is put
+  /// back into NMEA mode at `baud` either way.
+  bool uploadEpo(HardwareSerial& port, uint32_t baud, const char* path);
+
+  /// Have the writer store this boot's TTFF with its AIDED_* flags and
+  /// print recent boots.  Never waits on NVS.
+  void logTtff(uint32_t ms, uint8_t flags);
+
+private:
+  GpsAiding() = default;
+
+  static constexpr uint32_t SAVE_INTERVAL_MS = 5 * 60 * 1000;
+  static constexpr float    SAVE_MAX_HDOP    = 2.0f;
+
+  static void writerTask(void* arg);
+  void saveFix(const Record& r);
+  void saveTtff(uint32_t ms, uint8_t flags);
+
+  uint32_t lastSaveMs_ = 0;      // parser-task owned
+  bool     saved_      = false;
+  bool     clockSet_   = false;
+
+  // one slot each, handed to the writer; the parser owns a slot while its
+  // flag is clear
+  Record                pendingFix_;
+  std::atomic<bool>     fixPending_{false};
+  uint8_t               ttffFlags_ = 0;
+  std::atomic<uint32_t> ttffMs_{0};   // 0: nothing to log
+  TaskHandle_t          task_ = nullptr;
+};
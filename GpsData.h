@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include "Geo.h"
+
+/// Which sentences contributed to a published fix.
+enum : uint8_t {
+  GPS_PART_GGA = 1 << 0,
+  GPS_PART_RMC = 1 << 1,
+  GPS_PART_ALL = GPS_PART_GGA | GPS_PART_RMC,
+};
+
+struct GpsData {
+  uint32_t seq         = 0;     // one per receiver epoch
+  uint8_t  parts       = 0;     // GPS_PART_* bits present in this epoch
+  bool     fix         = false;
+  uint8_t  fixQuality  = 0;
+  Geo      pos;                 // degrees * 1e7
+  uint8_t  hour        = 0;
+  uint8_t  minute      = 0;
+  uint8_t  second      = 0;
+  uint16_t millis      = 0;
+  uint8_t  day         = 0;
+  uint8_t  month       = 0;
+  uint16_t year        = 0;
+  uint8_t  sats        = 0;
+  float    hdop        = 99.0f;
+  float    altitude    = 0.0f;
+  float    speedKnots  = 0.0f;
+  float    trackAngle  = 0.0f;
+};
@@ -0,0 +1,89 @@
+#include "GpsHistory.h"
+
+int GpsHistory::addWindow(uint32_t ms) {
+  if (nWindows_ >= MAX_WINDOWS) return -1;
+  Window& w = windows_[nWindows_];
+  w = Window{};
+  w.ms   = ms;
+  w.tail = head_;
+  return int(nWindows_++);
+}
+
+void GpsHistory::clear() {
+  head_     = 0;
+  count_    = 0;
+  anchored_ = false;
+  totalMm_  = 0;
+  for (size_t i = 0; i < nWindows_; ++i) {
+    uint32_t ms = windows_[i].ms;
+    windows_[i] = Window{};
+    windows_[i].ms = ms;
+  }
+}
+
+void GpsHistory::dropOldest(Window& w) {
+  const Entry& e = at(w.tail);
+  w.sumLat -= e.pos.lat;
+  w.sumLon -= e.pos.lon;
+  ++w.tail;
+  --w.count;
+}
+
+void GpsHistory::insert(uint32_t ms, const Geo& pos) {
+  // distance walked only advances once we leave the jitter radius
+  if (!anchored_) {
+    anchor_   = pos;
+    anchored_ = true;
+  } else {
+    float step = geo::distance(anchor_, pos);
+    if (step >= MIN_STEP_M) {
+      totalMm_ += uint32_t(step * 1000.0f);
+      anchor_   = pos;
+    }
+  }
+
+  // the slot we are about to overwrite must leave every window first
+  if (count_ == CAPACITY) {
+    size_t oldest = head_ - CAPACITY;
+    for (size_t i = 0; i < nWindows_; ++i)
+      if (windows_[i].count && windows_[i].tail == oldest)
+        dropOldest(windows_[i]);
+    --count_;
+  }
+
+  ring_[head_ % CAPACITY] = Entry{ ms, pos, totalMm_ };
+  ++head_;
+  ++count_;
+
+  for (size_t i = 0; i < nWindows_; ++i) {
+    Window& w = windows_[i];
+    w.sumLat += pos.lat;
+    w.sumLon += pos.lon;
+    ++w.count;
+    while (w.count > 1 && ms - at(w.tail).ms > w.ms)
+      dropOldest(w);
+  }
+}
+
+Geo GpsHistory::mean(int w) const {
+  const Window& win = windows_[w];
+  if (!win.count) return Geo{};
+  return Geo{ int32_t(win.sumLat / int64_t(win.count)),
+              int32_t(win.sumLon / int64_t(win.count)) };
+}
+
+float GpsHistory::walked(int w) const {
+  const Window& win = windows_[w];
+  if (!win.count) return 0.0f;
+  return (at(head_ - 1).walkedMm - at(win.tail).walkedMm) * 1e-3f;
+}
+
+float GpsHistory::speed(int w) const {
+  const Window& win = windows_[w];
+  if (win.count < 2) return 0.0f;
+  const Entry& first = at(win.tail);
+  const Entry& last  = at(head_ - 1);
+  uint32_t dt = last.ms - first.ms;
+  if (!dt) return 0.0f;
+  return geo::distance(first.pos, last.pos) * 1000.0f / dt;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Geo.h"
+
+/// Fixed-capacity ring of timestamped fixes with O(1) rolling queries.
+///
+/// Callers register a few time windows up front; every window keeps its own
+/// tail index and running sums, which insert() advances incrementally.  A
+/// query is then a subtraction and a divide — no scans, no allocation.
+class GpsHistory {
+public:
+  static constexpr size_t CAPACITY    = 512;  // ~51 s at 10 Hz
+  static constexpr size_t MAX_WINDOWS = 4;
+
+  /// Moves shorter than this are treated as fix jitter when summing the
+  /// distance walked.
+  static constexpr float MIN_STEP_M = 2.0f;
+
+  /// Track the last `ms` milliseconds; returns the window id, or -1 when
+  /// all slots are taken.  Windows longer than CAPACITY samples are
+  /// truncated to what the ring holds.
+  int addWindow(uint32_t ms);
+
+  void insert(uint32_t ms, const Geo& pos);
+  void clear();
+
+  size_t size() const { return count_; }
+
+  /// Mean position over the window.
+  Geo mean(int w) const;
+
+  /// Distance walked inside the window, metres.
+  float walked(int w) const;
+
+  /// Net ground speed across the window (oldest → newest), m/s.
+  float speed(int w) const;
+
+  /// Number of fixes currently inside the window.
+  size_t samples(int w) const { return windows_[w].count; }
+
+  /// Distance walked since clear(), metres.
+  float totalWalked() const { return totalMm_ * 1e-3f; }
+
+private:
+  struct Entry {
+    uint32_t ms;
+    Geo      pos;
+    uint32_t walkedMm;   // cumulative at this entry
+  };
+
+  struct Window {
+    uint32_t ms     = 0;
+    size_t   tail   = 0;   // absolute index of the oldest entry inside
+    size_t   count  = 0;
+    int64_t  sumLat = 0;
+    int64_t  sumLon = 0;
+  };
+
+  const Entry& at(size_t abs) const { return ring_[abs % CAPACITY]; }
+  void dropOldest(Window& w);
+
+  Entry    ring_[CAPACITY];
+  size_t   head_  = 0;   // absolute index of the next write
+  size_t   count_ = 0;
+
+  Window   windows_[MAX_WINDOWS];
+  size_t   nWindows_ = 0;
+
+  Geo      anchor_;
+  bool     anchored_ = false;
+  uint32_t totalMm_  = 0;
+};
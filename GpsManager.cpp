@@ -1,75 +1,235 @@
 #include "GpsManager.h"
+#include "Pmtk.h"
+#include "NmeaCapture.h"
+#include "GpsAiding.h"
+#include "SdCard.h"
+#include <SD_MMC.h>
 #include <Arduino.h>
 
+static constexpr uint32_t ACK_TIMEOUT_MS = 300;
+static constexpr uint8_t  ACK_RETRIES    = 3;
+static constexpr uint8_t  ACK_SUCCESS    = 3;
+static constexpr uint32_t RATE_STEPS[]   = { GPS_RATE_HZ, 5, 1 };
+
 GpsManager& GpsManager::instance() {
   static GpsManager inst;
   return inst;
 }
 
-GpsManager::GpsManager() = default;
+GpsManager::GpsManager() {
+  smoothWin_ = history_.addWindow(GPS_SMOOTH_MS);
+  motionWin_ = history_.addWindow(GPS_MOTION_MS);
+}
 
 void GpsManager::begin(HardwareSerial* port,
-                       uint32_t baud,
+                       uint32_t bootBaud,
                        int rxPin,
-                       int txPin,
-                       const char* outCmd,
-                       const char* hzCmd) {
+                       int txPin) {
   gpsSerial = port;
-  GPS       = new Adafruit_GPS(gpsSerial);
-
-  gpsSerial->begin(baud, SERIAL_8N1, rxPin, txPin);
-  GPS->begin(baud);
 
-  GPS->sendCommand(outCmd);
-  GPS->sendCommand(hzCmd);
-  GPS->sendCommand("$PMTK313,1*2E");
-  GPS->sendCommand("$PMTK301,2*2E");
+  gpsSerial->setRxBufferSize(rx_.capacity());
+  gpsSerial->begin(bootBaud, SERIAL_8N1, rxPin, txPin);
 
   Serial.begin(115200);  // only here
+
+  negotiateLink(bootBaud);
+  aid();
+
+  // Event-driven ingestion: the UART task pushes bytes as they arrive and
+  // the parser task sleeps until a sentence is complete.
+  xTaskCreate(parserTask, "gps", 4096, this, 2, &parserTask_);
+  gpsSerial->onReceiveError([this](hardwareSerial_error_t err) {
+    if (err == UART_FIFO_OVF_ERROR || err == UART_BUFFER_FULL_ERROR)
+      uartErrors_.fetch_add(1, std::memory_order_relaxed);
+  });
+  gpsSerial->onReceive([this] { onReceive(); });
+}
+
+void GpsManager::negotiateLink(uint32_t bootBaud) {
+  char cmd[64];
+  link_ = GpsLinkConfig{};
+  link_.baud = bootBaud;
+
+  // 1) Baud.  A backed-up receiver may still be at the target from the
+  //    last run; otherwise step it up and confirm at the new rate.
+  if (probe(GPS_LINK_BAUD)) {
+    link_.baud = GPS_LINK_BAUD;
+  } else if (probe(bootBaud)) {
+    pmtk::setBaud(cmd, sizeof(cmd), GPS_LINK_BAUD);
+    sendCommand(cmd);
+    gpsSerial->flush();
+    delay(50);
+    if (probe(GPS_LINK_BAUD)) link_.baud = GPS_LINK_BAUD;
+    else                      probe(bootBaud);   // fall back
+  } else {
+    gpsSerial->updateBaudRate(bootBaud);
+    Serial.println("GPS: no answer from receiver");
+  }
+
+  // 2) Only the sentences we parse
+  pmtk::setOutput(cmd, sizeof(cmd), GPS_NMEA_MIX);
+  if (command(cmd, 314)) link_.mix = GPS_NMEA_MIX;
+
+  // 3) Fastest fix rate the agreed baud and mix can carry
+  for (uint32_t hz : RATE_STEPS) {
+    if (nmea::utilizationPermille(link_.mix, hz, link_.baud)
+          > GPS_MAX_UTIL_PERMILLE) continue;
+    pmtk::setRate(cmd, sizeof(cmd), hz);
+    if (command(cmd, 220)) { link_.rateHz = hz; break; }
+  }
+
+  // SBAS on, WAAS DGPS mode; nice to have, not fatal
+  command("$PMTK313,1*2E", 313);
+  command("$PMTK301,2*2E", 301);
+
+  Serial.printf("GPS link: %lu baud, %lu Hz, mix 0x%05lx (%lu permille)\n",
+                (unsigned long)link_.baud, (unsigned long)link_.rateHz,
+                (unsigned long)link_.mix,
+                (unsigned long)nmea::utilizationPermille(
+                  link_.mix, link_.rateHz, link_.baud));
+}
+
+void GpsManager::aid() {
+  auto& aiding = GpsAiding::instance();
+  aiding.begin();
+  char cmd[96];
+
+  // time and position are only worth sending with a trustworthy clock
+  pmtk::UtcTime now;
+  GpsAiding::Record last;
+  if (aiding.clockTime(now)) {
+    pmtk::setTime(cmd, sizeof(cmd), now);
+    if (command(cmd, 740)) aided_ |= GpsAiding::AIDED_TIME;
+    if (aiding.load(last)) {
+      pmtk::setPosition(cmd, sizeof(cmd), last.pos, last.altitude, now);
+      if (command(cmd, 741)) aided_ |= GpsAiding::AIDED_POSITION;
+    }
+  }
+
+  if (sdcard::mount() && SD_MMC.exists(GPS_EPO_PATH) &&
+      aiding.uploadEpo(*gpsSerial, link_.baud, GPS_EPO_PATH))
+    aided_ |= GpsAiding::AIDED_EPO;
+}
+
+bool GpsManager::probe(uint32_t baud) {
+  char cmd[16];
+  gpsSerial->updateBaudRate(baud);
+  pmtk::test(cmd, sizeof(cmd));
+  return command(cmd, 0);
+}
+
+bool GpsManager::command(const char* cmd, uint16_t id) {
+  for (uint8_t i = 0; i < ACK_RETRIES; ++i) {
+    sendCommand(cmd);
+    if (waitAck(id)) return true;
+  }
+  return false;
+}
+
+bool GpsManager::waitAck(uint16_t id) {
+  NmeaParser p;
+  uint32_t t0 = millis();
+  while (millis() - t0 < ACK_TIMEOUT_MS) {
+    while (gpsSerial->available()) {
+      if (p.feed(char(gpsSerial->read())) == NmeaParser::Sentence::Ack
+          && p.ackCommand() == id)
+        return p.ackFlag() == ACK_SUCCESS;
+    }
+    delay(1);
+  }
+  return false;
+}
+
+void GpsManager::sendCommand(const char* cmd) {
+  gpsSerial->print(cmd);
+  gpsSerial->print("\r\n");
+}
+
+void GpsManager::onReceive() {
+  uint8_t chunk[128];
+  bool eol = false;
+  size_t n;
+  while ((n = gpsSerial->available()) > 0) {
+    n = gpsSerial->read(chunk, n < sizeof(chunk) ? n : sizeof(chunk));
+    NmeaCapture::instance().append(micros(), chunk, n);
+    rx_.write(chunk, n);
+    if (memchr(chunk, '\n', n)) eol = true;
+  }
+  if (eol) xTaskNotifyGive(parserTask_);
+}
+
+void GpsManager::parserTask(void* arg) {
+  auto self = static_cast<GpsManager*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    self->update();
+  }
 }
 
 void GpsManager::update() {
-  // 1) Drain parser buffer
-  while (GPS->read()) { /* no-op */ }
-
-  // 2) If new NMEA, parse and update data_
-  if (GPS->newNMEAreceived()) {
-    char* nmea = GPS->lastNMEA();
-    if (!strncmp(nmea, "$GPGGA", 6) ||
-        !strncmp(nmea, "$GNGGA", 6) ||
-        !strncmp(nmea, "$GPRMC", 6) ||
-        !strncmp(nmea, "$GNRMC", 6)) {
-
-      GPS->parse(nmea);
-      data_.fix        = GPS->fix;
-      data_.fixQuality = GPS->fixquality;
-      data_.lat        = GPS->latitudeDegrees;
-      data_.lon        = GPS->longitudeDegrees;
-      data_.hour       = GPS->hour;
-      data_.minute     = GPS->minute;
-      data_.second     = GPS->seconds;
-      data_.day        = GPS->day;
-      data_.month      = GPS->month;
-      data_.year       = GPS->year + 2000;
-      data_.sats       = GPS->satellites;
-      data_.hdop       = GPS->HDOP;
-      data_.altitude   = GPS->altitude;
-      data_.speedKnots = GPS->speed;
-      data_.trackAngle = GPS->angle;
-
-      newData_ = true;
+  // Tokenize in place out of the ring; a fix is published once per
+  // receiver epoch, after its GGA and RMC have both checked out.
+  uint32_t t0 = micros();
+  const uint8_t* p;
+  size_t n;
+  while ((n = rx_.peek(p)) > 0) {
+    for (size_t i = 0; i < n; ++i) {
+      auto s = parser_.feed(char(p[i]));
+      if (s != NmeaParser::Sentence::None) stats_.countSentence(parser_.type());
+      if (epoch_.add(parser_, s)) {
+        published_.store(epoch_.latest());
+        newData_.store(true, std::memory_order_release);
+        record(epoch_.latest());
+      }
     }
+    rx_.consume(n);
+  }
+  stats_.countParse(micros() - t0);
+
+  uint32_t now = millis();
+  if (now - stats_.uptimeMs >= 1000) {
+    stats_.checksumErrors = parser_.checksumErrors();
+    stats_.truncated      = parser_.truncated();
+    stats_.ringOverruns   = rx_.overruns();
+    stats_.uartErrors     = uartErrors_.load(std::memory_order_relaxed);
+    stats_.ringHighWater  = rx_.highWater();
+    stats_.ringCapacity   = rx_.capacity();
+    stats_.roll(now);
+    statsPub_.store(stats_);
   }
 }
 
+void GpsManager::record(const GpsData& d) {
+  if (d.fix && !firstFix_) {
+    firstFix_ = true;
+    GpsAiding::instance().logTtff(millis(), aided_);
+  }
+  GpsAiding::instance().onFix(d);
+
+  if (!d.fix || d.hdop > GPS_HISTORY_MAX_HDOP) return;
+  history_.insert(millis(), d.pos);
+
+  GpsMotion m;
+  m.seq     = d.seq;
+  m.samples = history_.samples(smoothWin_);
+  m.mean    = history_.mean(smoothWin_);
+  m.speed   = history_.speed(motionWin_);
+  m.walked  = history_.totalWalked();
+  m.stopped = m.speed < GPS_STOPPED_MPS;
+  motion_.store(m);
+}
+
+void GpsManager::dumpStats(Print& out) const {
+  uint8_t frame[NmeaStats::SERIALIZED_MAX];
+  size_t n = linkStats().serialize(frame, sizeof(frame));
+  out.write(frame, n);
+}
+
 bool GpsManager::hasNewData() {
-  return newData_;
+  return newData_.load(std::memory_order_acquire);
 }
 
 GpsData GpsManager::fetchData() {
-  noInterrupts();
-  GpsData snapshot = data_;
-  newData_ = false;
-  interrupts();
-  return snapshot;
+  newData_.store(false, std::memory_order_relaxed);
+  return published_.load();
 }
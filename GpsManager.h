@@ -1,49 +1,118 @@
 #pragma once
 
 #include <Arduino.h>
-#include <Adafruit_GPS.h>
 #include <HardwareSerial.h>
+#include "GpsData.h"
+#include "NmeaParser.h"
+#include "EpochAssembler.h"
+#include "GpsHistory.h"
+#include "NmeaStats.h"
+#include "Seqlock.h"
+#include "ByteRing.h"
+#include "NmeaBudget.h"
+#include <atomic>
 
-struct GpsData {
-  bool     fix         = false;
-  uint8_t  fixQuality  = 0;
-  float    lat         = 0.0f;
-  float    lon         = 0.0f;
-  uint8_t  hour        = 0;
-  uint8_t  minute      = 0;
-  uint8_t  second      = 0;
-  uint8_t  day         = 0;
-  uint8_t  month       = 0;
-  uint16_t year        = 0;
-  uint8_t  sats        = 0;
-  float    hdop        = 99.0f;
-  float    altitude    = 0.0f;
-  float    speedKnots  = 0.0f;
-  float    trackAngle  = 0.0f;
+/// Link begin() negotiates the receiver up to.  The mix is only what the
+/// parser consumes; it also sizes the RX ring.
+static constexpr uint32_t GPS_LINK_BAUD = 115200;
+static constexpr uint32_t GPS_RATE_HZ   = 10;
+static constexpr uint32_t GPS_NMEA_MIX  = nmea::MIX_PARSED;
+
+/// Worst-case NMEA traffic must stay under this share of the UART.
+static constexpr uint32_t GPS_MAX_UTIL_PERMILLE = 500;
+static_assert(nmea::utilizationPermille(GPS_NMEA_MIX, GPS_RATE_HZ,
+                                        GPS_LINK_BAUD) <= GPS_MAX_UTIL_PERMILLE,
+              "GPS sentence mix / rate would saturate the UART");
+
+/// What the receiver actually agreed to.
+struct GpsLinkConfig {
+  uint32_t baud   = 0;
+  uint32_t rateHz = 1;
+  uint32_t mix    = nmea::MIX_ALLDATA;
+};
+
+/// EPO ephemeris file uploaded from SD at boot, if present.
+static constexpr const char* GPS_EPO_PATH = "/epo/MTK14.EPO";
+
+/// Rolling summary of the fix history, republished every epoch.
+static constexpr uint32_t GPS_SMOOTH_MS   = 5000;   // mean position
+static constexpr uint32_t GPS_MOTION_MS   = 10000;  // speed / stop detection
+static constexpr float    GPS_HISTORY_MAX_HDOP = 3.0f;
+static constexpr float    GPS_STOPPED_MPS = 0.3f;
+
+struct GpsMotion {
+  uint32_t seq      = 0;      // epoch this summary follows
+  uint16_t samples  = 0;      // fixes in the smoothing window
+  Geo      mean;              // mean position over GPS_SMOOTH_MS
+  float    speed    = 0.0f;   // net ground speed over GPS_MOTION_MS, m/s
+  float    walked   = 0.0f;   // since boot, m
+  bool     stopped  = false;
 };
 
 class GpsManager {
 public:
   static GpsManager& instance();
 
+  /// Open the UART at the receiver's power-on baud, negotiate the link
+  /// above, then start event-driven ingestion.
   void begin(HardwareSerial* port,
-             uint32_t baud,
+             uint32_t bootBaud,
              int rxPin,
-             int txPin,
-             const char* outCmd = PMTK_SET_NMEA_OUTPUT_ALLDATA,
-             const char* hzCmd  = PMTK_SET_NMEA_UPDATE_5HZ);
+             int txPin);
+
+  GpsLinkConfig     link() const { return link_; }
 
-  /// Called from ISR
+  /// Drain the RX ring into the parser.  Runs on the GPS parser task,
+  /// which is woken at the end of each sentence; the only writer.
   void update();
 
-  /// Called from loop()
+  /// Link health, republished once a second
+  NmeaStats         linkStats() const { return statsPub_.load(); }
+
+  /// linkStats() as a compact binary frame (NmeaStats::serialize)
+  void              dumpStats(Print& out) const;
+
+  /// Lock-free, callable from any task or core
   bool              hasNewData();
   GpsData           fetchData();
+  GpsMotion         fetchMotion() const { return motion_.load(); }
 
 private:
   GpsManager();
+
+  /// UART event task: bulk read into rx_, wake the parser on '\n'
+  void onReceive();
+  static void parserTask(void* arg);
+
+  /// Feed a published epoch into the history and republish the summary
+  void record(const GpsData& d);
+
+  // PMTK negotiation; runs in begin() before ingestion starts
+  void negotiateLink(uint32_t bootBaud);
+  bool probe(uint32_t baud);
+  bool command(const char* cmd, uint16_t id);
+  bool waitAck(uint16_t id);
+  void sendCommand(const char* cmd);
+
+  /// Hot-start aiding from NVS / SD; runs after negotiateLink()
+  void aid();
+
   HardwareSerial*   gpsSerial = nullptr;
-  Adafruit_GPS*     GPS       = nullptr;
-  GpsData           data_;
-  volatile bool     newData_  = false;
+  GpsLinkConfig     link_;
+  uint8_t           aided_    = 0;   // GpsAiding::AIDED_* used this boot
+  bool              firstFix_ = false;
+  TaskHandle_t      parserTask_ = nullptr;
+  // 4 epochs: still absorbs a full ALLDATA burst if the mask is refused
+  ByteRing<nmea::ringCapacity(GPS_NMEA_MIX, 4)> rx_;
+  std::atomic<uint32_t> uartErrors_{0};
+  NmeaParser        parser_;
+  NmeaStats         stats_;     // writer-side
+  Seqlock<NmeaStats> statsPub_;
+  EpochAssembler    epoch_;     // writer-side working state
+  GpsHistory        history_;
+  int               smoothWin_ = -1;
+  int               motionWin_ = -1;
+  Seqlock<GpsMotion> motion_;
+  Seqlock<GpsData>  published_;
+  std::atomic<bool> newData_{false};
 };
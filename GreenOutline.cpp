@@ -0,0 +1,60 @@
+#include "GreenOutline.h"
+#include <math.h>
+
+bool GreenOutline::add(const geo::Vec2& v) {
+  if (n_ >= MAX_POINTS) return false;
+  x_[n_] = v.x;
+  y_[n_] = v.y;
+  ++n_;
+  return true;
+}
+
+bool GreenOutline::edges(const geo::Vec2& from, const geo::Vec2& toward,
+                         const geo::LocalFrame& frame,
+                         float& front, float& back) const {
+  if (!valid()) return false;
+
+  geo::Vec2 dir = frame.delta(from, toward);
+  float len = sqrtf(dir.x * dir.x + dir.y * dir.y);
+  if (len <= 0.0f) return false;
+  const float ux = dir.x / len, uy = dir.y / len;
+
+  // vertices relative to the player, closed by repeating the first
+  alignas(16) float rx[MAX_POINTS + 1];
+  alignas(16) float ry[MAX_POINTS + 1];
+  const float sx = frame.xSlope(), sy = frame.ySlope();
+  for (size_t i = 0; i < n_; ++i) {
+    float m = 0.5f * (y_[i] + from.y);
+    rx[i] = (x_[i] - from.x) * (1.0f + sx * m);
+    ry[i] = (y_[i] - from.y) * (1.0f + sy * m);
+  }
+  rx[n_] = rx[0];
+  ry[n_] = ry[0];
+
+  // crossing-number rule: an edge counts only when its ends lie strictly
+  // on opposite sides of the line (a vertex on the line goes with the
+  // left side), so grazing a vertex or running along an edge is no
+  // crossing and a vertex the line passes through counts once
+  alignas(16) float side[MAX_POINTS + 1];
+  for (size_t i = 0; i <= n_; ++i) side[i] = ux * ry[i] - uy * rx[i];
+
+  float tMin = INFINITY, tMax = -INFINITY;
+  unsigned hits = 0;
+  for (size_t i = 0; i < n_; ++i) {
+    if ((side[i] > 0.0f) == (side[i + 1] > 0.0f)) continue;
+    float s = side[i] / (side[i] - side[i + 1]);
+    float px = rx[i] + s * (rx[i + 1] - rx[i]);
+    float py = ry[i] + s * (ry[i + 1] - ry[i]);
+    float t = px * ux + py * uy;
+    if (t < 0.0f) continue;                           // behind the player
+    tMin = fminf(tMin, t);
+    tMax = fmaxf(tMax, t);
+    ++hits;
+  }
+  if (!hits) return false;
+
+  // an odd number of crossings ahead means we start inside
+  front = (hits & 1) ? 0.0f : tMin;
+  back  = tMax;
+  return true;
+}
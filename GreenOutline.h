@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Geo.h"
+
+/// A green's outline in the course's local frame, kept structure-of-arrays
+/// so the per-fix work is straight loops over floats.
+///
+/// edges() casts the line of sight from the player through the pin and
+/// intersects it with every outline segment, which gives the front and
+/// back of the green as they are from where the player stands rather
+/// than from the one approach the fixed front/back points assume.
+class GreenOutline {
+public:
+  static constexpr size_t MAX_POINTS = 64;
+
+  void clear() { n_ = 0; }
+
+  /// Append the next vertex (either winding); false when full.
+  bool add(const geo::Vec2& v);
+
+  size_t size() const { return n_; }
+
+  /// A polygon needs three vertices.
+  bool valid() const { return n_ >= 3; }
+
+  /// Distances (m) along the line from `from` through `toward` to where it
+  /// first enters and last leaves the outline; `front` is 0 when `from` is
+  /// already on the green.  Offsets are rescaled like frame.delta().
+  /// False when the line misses the green.
+  bool edges(const geo::Vec2& from, const geo::Vec2& toward,
+             const geo::LocalFrame& frame, float& front, float& back) const;
+
+private:
+  alignas(16) float x_[MAX_POINTS];
+  alignas(16) float y_[MAX_POINTS];
+  size_t n_ = 0;
+};
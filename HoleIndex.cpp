@@ -0,0 +1,126 @@
+#include "HoleIndex.h"
+#include <math.h>
+
+void HoleIndex::add(const geo::Vec2& tee, const geo::Vec2& green) {
+  if (segs_.size() >= MAX_HOLES) return;
+  segs_.push_back(Segment{ tee, green });
+}
+
+float HoleIndex::dist2(const Segment& s, const geo::Vec2& p) {
+  float vx = s.b.x - s.a.x, vy = s.b.y - s.a.y;
+  float wx = p.x - s.a.x,   wy = p.y - s.a.y;
+  float len2 = vx * vx + vy * vy;
+  float t = len2 > 0.0f ? (wx * vx + wy * vy) / len2 : 0.0f;
+  t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+  float dx = wx - t * vx, dy = wy - t * vy;
+  return dx * dx + dy * dy;
+}
+
+void HoleIndex::build() {
+  cells_.clear();
+  nx_ = ny_ = 0;
+  if (segs_.empty()) return;
+
+  float x0 = segs_[0].a.x, x1 = x0, y0 = segs_[0].a.y, y1 = y0;
+  for (const Segment& s : segs_) {
+    x0 = fminf(x0, fminf(s.a.x, s.b.x));  x1 = fmaxf(x1, fmaxf(s.a.x, s.b.x));
+    y0 = fminf(y0, fminf(s.a.y, s.b.y));  y1 = fmaxf(y1, fmaxf(s.a.y, s.b.y));
+  }
+  x0 -= HALF_WIDTH;  x1 += HALF_WIDTH;
+  y0 -= HALF_WIDTH;  y1 += HALF_WIDTH;
+
+  // square cells, as small as the cell budget allows
+  float cell = fmaxf(MIN_CELL_M, fmaxf(x1 - x0, y1 - y0) / MAX_CELLS);
+  nx_ = uint16_t(ceilf((x1 - x0) / cell));
+  ny_ = uint16_t(ceilf((y1 - y0) / cell));
+  x0_ = x0;
+  y0_ = y0;
+  invCell_ = 1.0f / cell;
+  cells_.assign(size_t(nx_) * ny_, 0);
+
+  // a capsule touches a cell if it reaches within half a diagonal of the
+  // cell's centre; conservative, locate() does the exact test
+  float reach = HALF_WIDTH + cell * 0.7072f;
+  float reach2 = reach * reach;
+  for (uint16_t cy = 0; cy < ny_; ++cy) {
+    for (uint16_t cx = 0; cx < nx_; ++cx) {
+      geo::Vec2 c{ x0 + (cx + 0.5f) * cell, y0 + (cy + 0.5f) * cell };
+      uint64_t mask = 0;
+      for (size_t h = 0; h < segs_.size(); ++h)
+        if (dist2(segs_[h], c) <= reach2) mask |= uint64_t(1) << h;
+      cells_[size_t(cy) * nx_ + cx] = mask;
+    }
+  }
+}
+
+int HoleIndex::locate(const geo::Vec2& p, int current) const {
+  float fx = (p.x - x0_) * invCell_;
+  float fy = (p.y - y0_) * invCell_;
+  if (fx < 0.0f || fy < 0.0f || fx >= nx_ || fy >= ny_) return -1;
+
+  // lowest hole first, so an exact tie keeps the lower one
+  uint64_t mask = cells_[size_t(fy) * nx_ + size_t(fx)];
+  int   best  = -1;
+  float best2 = HALF_WIDTH * HALF_WIDTH;
+  float cur2  = -1.0f, next2 = -1.0f;
+  while (mask) {
+    int h = __builtin_ctzll(mask);
+    mask &= mask - 1;
+    float d2 = dist2(segs_[h], p);
+    if (h == current) cur2 = d2;
+    if (h == current + 1 && current >= 0) next2 = d2;
+    if (d2 < best2) {
+      best2 = d2;
+      best  = h;
+    }
+  }
+  if (best < 0) return -1;
+  // the hole being played, then the one after it, unless clearly off them
+  float bestD = sqrtf(best2);
+  if (cur2 >= 0.0f && cur2 < HALF_WIDTH * HALF_WIDTH &&
+      sqrtf(cur2) - bestD < SWITCH_MARGIN)
+    return current;
+  if (next2 >= 0.0f && next2 < HALF_WIDTH * HALF_WIDTH &&
+      sqrtf(next2) - bestD < SWITCH_MARGIN)
+    return current + 1;
+  return best;
+}
+
+void HoleTracker::setRate(uint32_t fixHz) {
+  float hz = float(fixHz ? fixHz : 1);
+  confirm_ = uint16_t(lroundf(CONFIRM_S * hz));
+  teeVote_ = uint16_t(lroundf(TEE_VOTE_S * hz));
+  confirm_ = confirm_ ? confirm_ : 1;
+  count_   = 0;
+}
+
+bool HoleTracker::update(int hole) {
+  if (hole < 0 || hole == current_) {
+    count_ = 0;
+    return false;
+  }
+  return vote(hole, 1);
+}
+
+bool HoleTracker::teeEntered(int hole) {
+  if (hole < 0 || hole == current_) return false;
+  return vote(hole, teeVote_);
+}
+
+bool HoleTracker::vote(int hole, uint16_t fixes) {
+  if (hole != candidate_) {
+    candidate_ = hole;
+    count_ = 0;
+  }
+  count_ = uint16_t(count_ + fixes);
+  if (count_ < confirm_) return false;
+  current_ = hole;
+  count_ = 0;
+  return true;
+}
+
+void HoleTracker::reset(int hole) {
+  current_   = hole;
+  candidate_ = -1;
+  count_     = 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+#include "Geo.h"
+
+/// Which hole of a course a point lies on.
+///
+/// Each hole is a capsule: its tee-to-green line widened by HALF_WIDTH.  A
+/// uniform grid over the course's local frame holds, per cell, a bitmask of
+/// the capsules that touch it, so a lookup is one cell read plus a
+/// point-to-segment distance for the handful of holes sharing that cell.
+/// Built once per course, when its hole page opens.
+class HoleIndex {
+public:
+  static constexpr size_t MAX_HOLES  = 64;      // one mask bit each
+  static constexpr float  HALF_WIDTH = 40.0f;   // m either side of the line
+  static constexpr size_t MAX_CELLS  = 32;      // per axis, 8 KB at most
+  static constexpr float  MIN_CELL_M = 25.0f;
+  /// How much nearer another hole's line must be before it beats the
+  /// current one, or the next one in play.  A hole tees off at the previous
+  /// green, so on that green both lines are about equally near; this
+  /// covers a player anywhere on a green round the pin.
+  static constexpr float  SWITCH_MARGIN = 20.0f;
+
+  /// Append the next hole as tee -> green, in frame metres.  Holes past
+  /// MAX_HOLES are ignored.
+  void add(const geo::Vec2& tee, const geo::Vec2& green);
+
+  /// Rasterise the capsules into the grid; call after the last add().
+  void build();
+
+  /// Index of the hole whose line is nearest `p`, or -1 when `p` is on
+  /// none of them.  `current`, when `p` is on it, is kept unless another
+  /// line is SWITCH_MARGIN nearer; failing that the hole after it is
+  /// preferred the same way, and exact ties go to the lower hole.
+  int locate(const geo::Vec2& p, int current = -1) const;
+
+  size_t size() const { return segs_.size(); }
+
+  /// Heap held by the segments and grid.
+  size_t bytes() const {
+    return segs_.capacity() * sizeof(Segment)
+         + cells_.capacity() * sizeof(uint64_t);
+  }
+
+private:
+  struct Segment {
+    geo::Vec2 a, b;
+  };
+
+  static float dist2(const Segment& s, const geo::Vec2& p);
+
+  std::vector<Segment>  segs_;
+  std::vector<uint64_t> cells_;   // row-major, nx_ * ny_
+  float    x0_ = 0.0f, y0_ = 0.0f;
+  float    invCell_ = 0.0f;
+  uint16_t nx_ = 0, ny_ = 0;
+};
+
+/// Hysteresis over HoleIndex::locate(): a different hole is only accepted
+/// after it wins every lookup for CONFIRM_S, so a run of noisy fixes or a
+/// walk along a shared boundary doesn't flip the page.  Fixes that land
+/// on no hole keep the current one.  Stepping onto a tee is a strong
+/// vote: it stands for TEE_VOTE_S of lookups, and the rest must follow.
+class HoleTracker {
+public:
+  static constexpr float CONFIRM_S  = 3.0f;
+  static constexpr float TEE_VOTE_S = 2.0f;
+
+  /// Scale the windows above to the receiver's fix rate.
+  void setRate(uint32_t fixHz);
+
+  /// Feed one lookup; true when the confirmed hole changed.
+  bool update(int hole);
+
+  /// The player entered `hole`'s tee; true when the confirmed hole changed.
+  bool teeEntered(int hole);
+
+  void reset(int hole = -1);
+
+  int current() const { return current_; }
+  uint16_t confirmFixes() const { return confirm_; }
+
+private:
+  bool vote(int hole, uint16_t fixes);
+
+  int      current_   = -1;
+  int      candidate_ = -1;
+  uint16_t count_     = 0;
+  uint16_t confirm_   = 3;   // 1 Hz until setRate()
+  uint16_t teeVote_   = 2;
+};
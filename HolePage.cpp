@@ -4,7 +4,6 @@
 #include "Layout.h"        // for LCD_WIDTH, PAD
 #include <lvgl.h>
 #include <algorithm>       // for std::clamp
-#include <cmath>           // for haversine
 #include <cstdio>          // for snprintf
 #include "lv_font_montserrat_64.h"
 #include "lv_font_montserrat_56.h"
@@ -12,18 +11,6 @@
 
 using std::clamp;
 
-// ─── haversine helper ───────────────────────────────────────────────────
-static constexpr double R_earth = 6'371'000.0;
-static double haversine(double lat1, double lon1,
-                        double lat2, double lon2) {
-  auto toRad = [](double d){ return d * M_PI/180.0; };
-  double dlat = toRad(lat2 - lat1), dlon = toRad(lon2 - lon1);
-  double a = sin(dlat/2)*sin(dlat/2)
-           + cos(toRad(lat1))*cos(toRad(lat2))
-             * sin(dlon/2)*sin(dlon/2);
-  return R_earth * 2 * atan2(sqrt(a), sqrt(1 - a));
-}
-
 HolePage::HolePage(int courseIdx)
   : courseIdx_(courseIdx) {}
 
@@ -31,7 +18,7 @@ void HolePage::onCreate() {
   // 1) Initial header string "#1  Par 4"
   char buf[32];
   auto& holes = CoursesManager::instance()
-                             .getCourses()[courseIdx_].holes;
+                             .course(courseIdx_).holes;
   if (!holes.empty()) {
     snprintf(buf, sizeof(buf), "#%d  Par %d",
              holes[0].number, holes[0].par);
@@ -77,22 +64,60 @@ void HolePage::onCreate() {
   lv_obj_set_style_text_color(lblBack_, lv_color_white(), LV_PART_MAIN);
   lv_obj_align(lblBack_, LV_ALIGN_CENTER, -quarter, +fh);
 
-  // 5) Show hole #0
+  // HAZARDS
+  lblHazards_ = lv_label_create(scr_);
+  lv_obj_set_width(lblHazards_, LCD_WIDTH/2 - PAD*2);
+  lv_obj_set_style_text_align(lblHazards_, LV_TEXT_ALIGN_LEFT, LV_PART_MAIN);
+  lv_obj_set_style_text_font(lblHazards_, &lv_font_montserrat_22, LV_PART_MAIN);
+  lv_obj_set_style_text_color(lblHazards_, lv_color_hex(0xFF8C00), LV_PART_MAIN);
+  lv_obj_align(lblHazards_, LV_ALIGN_CENTER, +quarter, 0);
+  lv_label_set_text(lblHazards_, "");
+
+  // 5) Hole lookup over this course, and its fences (the main loop
+  // feeds those fixes)
+  buildHoleIndex(CoursesManager::instance().course(courseIdx_));
+  tracker_.setRate(GpsManager::instance().link().rateHz);
+  auto& fences = GeofenceEngine::instance();
+  CoursesManager::instance().buildFences(courseIdx_, fences);
+  fenceSub_ = fences.subscribe([this](const FenceEvent& e) { onFence(e); });
+
+  // 6) Show hole #0
   navigateTo(0);
   updateDistances(GpsManager::instance().fetchData());
 }
 
 void HolePage::onDestroy() {
+  GeofenceEngine::instance().unsubscribe(fenceSub_);
   Page::onDestroy();
 }
 
+void HolePage::printStats(Print& out) const {
+  out.printf("HolePage: %u fixes recomputed, %u gated, %u stale ticks; "
+             "%u label writes, %u skipped (%u px not redrawn)\n",
+             gate_.passed(), gate_.skipped(), staleTicks_,
+             labelWrites_, labelSkips_, pxSkipped_);
+}
+
+void HolePage::onFence(const FenceEvent& e) {
+  if (e.kind != FenceKind::Tee || !e.entered) return;
+  if (tracker_.teeEntered(e.hole) && tracker_.current() != holeIdx_)
+    navigateTo(tracker_.current());
+}
+
 void HolePage::navigateTo(int newIdx) {
   auto& holes = CoursesManager::instance()
-                             .getCourses()[courseIdx_].holes;
+                             .course(courseIdx_).holes;
   if (holes.empty()) return;
 
   holeIdx_ = clamp(newIdx, 0, int(holes.size()) - 1);
   const auto& hole = holes[holeIdx_];
+  buildTargets(CoursesManager::instance().course(courseIdx_), hole);
+
+  // new targets: recompute on the next fix and redraw whatever it gives
+  gate_.reset();
+  shownFront_.reset();
+  shownMid_.reset();
+  shownBack_.reset();
 
   lv_label_set_text_fmt(
     hdrLabel_,
@@ -102,31 +127,81 @@ void HolePage::navigateTo(int newIdx) {
   );
 }
 
+void HolePage::buildTargets(const Course& course, const Hole& hole) {
+  const auto& f = course.frame;
+  targets_.clear();
+  tgtPin_   = targets_.add(TargetKind::Pin,   f.toLocal(hole.pin));
+  tgtFront_ = targets_.add(TargetKind::Front, f.toLocal(hole.front));
+  tgtBack_  = targets_.add(TargetKind::Back,  f.toLocal(hole.back));
+  // hazards before layups, so a crowded hole loses layups first; the
+  // course compiler warns about holes with more than fit
+  for (size_t i = 0; i < hole.hazards.size(); ++i)
+    targets_.add(TargetKind::Hazard, f.toLocal(hole.hazards[i].loc),
+                 uint8_t(i), hole.hazards[i].radius);
+  for (size_t i = 0; i < hole.layups.size(); ++i)
+    targets_.add(TargetKind::Layup, f.toLocal(hole.layups[i]), uint8_t(i));
+
+  // a truncated outline would close on a made-up chord; an empty one
+  // leaves front/back to the stored points instead (the compiler warns)
+  green_.clear();
+  for (const Geo& g : hole.green)
+    if (!green_.add(f.toLocal(g))) {
+      green_.clear();
+      break;
+    }
+}
+
+// every hole's tee-to-green line; the compiler already filled in tees
+void HolePage::buildHoleIndex(const Course& course) {
+  for (const Hole& h : course.holes)
+    holeIndex_.add(course.frame.toLocal(h.tee), course.frame.toLocal(h.pin));
+  holeIndex_.build();
+}
+
 void HolePage::onGpsUpdate(const GpsData& d) {
+  // the page timer outpaces the receiver; only new epochs count
+  if (d.fix && d.seq == lastSeq_) {
+    ++staleTicks_;
+    return;
+  }
+  lastSeq_ = d.seq;
+  followHole(d);
   updateDistances(d);
 }
 
-void HolePage::updateDistances(const GpsData& d) {
-  auto& holes = CoursesManager::instance()
-                             .getCourses()[courseIdx_].holes;
-  if (holes.empty()) return;
-  const auto& hole = holes[holeIdx_];
+void HolePage::followHole(const GpsData& d) {
+  if (!d.fix) return;
+  const auto& course = CoursesManager::instance().course(courseIdx_);
+  int hole = holeIndex_.locate(course.frame.toLocal(d.pos), tracker_.current());
+  if (tracker_.update(hole) && tracker_.current() != holeIdx_)
+    navigateTo(tracker_.current());
+}
 
-  // ensure labels visible
-  lv_obj_clear_flag(lblFront_, LV_OBJ_FLAG_HIDDEN);
-  lv_obj_clear_flag(lblMid_,   LV_OBJ_FLAG_HIDDEN);
-  lv_obj_clear_flag(lblBack_,  LV_OBJ_FLAG_HIDDEN);
+void HolePage::updateDistances(const GpsData& d) {
+  const auto& course = CoursesManager::instance().course(courseIdx_);
+  if (course.holes.empty()) return;
 
   if (d.fix) {
-    double df = haversine(d.lat, d.lon, hole.front.lat, hole.front.lon);
-    double db = haversine(d.lat, d.lon, hole.back.lat,  hole.back.lon);
-    double dm = (df + db) / 2.0;
+    // project once; skip the rest while we're within the fix noise
+    geo::Vec2 here = course.frame.toLocal(d.pos);
+    if (!gate_.pass(here, d.hdop)) return;
+
+    // one batched pass over every target on the hole
+    targets_.solve(here, course.frame);
+    float df = targets_.distance(tgtFront_);
+    float db = targets_.distance(tgtBack_);
+    // with an outline, the edges where our line to the pin crosses it
+    if (green_.valid())
+      green_.edges(here, targets_.position(tgtPin_), course.frame, df, db);
+    shownFront_.update(df, DISPLAY_BAND_M);
+    shownMid_.update(targets_.distance(tgtPin_), DISPLAY_BAND_M);   // the pin
+    shownBack_.update(db, DISPLAY_BAND_M);
 
     char buf[16];
-    auto fmt = [&](double m) {
-      if (m >= 1000.0) {
+    auto fmt = [&](float m) {
+      if (m >= 1000.0f) {
         // show kilometers to 1 decimal, e.g. "1.2"
-        snprintf(buf, sizeof(buf), "%.1f", m / 1000.0);
+        snprintf(buf, sizeof(buf), "%.1f", m / 1000.0f);
       } else {
         // show meters as integer, e.g. "999"
         snprintf(buf, sizeof(buf), "%d", int(m));
@@ -134,16 +209,42 @@ void HolePage::updateDistances(const GpsData& d) {
       return buf;
     };
 
-    lv_label_set_text(lblFront_, fmt(df));
-    lv_label_set_text(lblMid_,   fmt(dm));
-    lv_label_set_text(lblBack_,  fmt(db));
+    setLabel(lblFront_, fmt(shownFront_.value()));
+    setLabel(lblMid_,   fmt(shownMid_.value()));
+    setLabel(lblBack_,  fmt(shownBack_.value()));
+
+    updateHazards(course.holes[holeIdx_]);
   }
   else {
     // no fix: placeholders
-    lv_label_set_text(lblFront_, "360");
-    lv_label_set_text(lblMid_,   "345");
-    lv_label_set_text(lblBack_,  "329");
+    gate_.reset();
+    setLabel(lblFront_, "360");
+    setLabel(lblMid_,   "345");
+    setLabel(lblBack_,  "329");
+    setLabel(lblHazards_, "");
+  }
+}
+
+void HolePage::updateHazards(const Hole& hole) {
+  TargetAhead ahead[HAZARDS_SHOWN];
+  size_t n = targets_.ahead(tgtPin_, TargetKind::Hazard, HAZARD_CORRIDOR,
+                            ahead, HAZARDS_SHOWN);
+
+  char buf[HAZARDS_SHOWN * 40] = "";
+  size_t len = 0;
+  for (size_t i = 0; i < n && len < sizeof(buf); ++i) {
+    const Hazard& hz = hole.hazards[targets_.ref(ahead[i].slot)];
+    int reach = int(std::max(ahead[i].reach, 0.0f));
+    int carry = int(ahead[i].carry);
+    char side = ahead[i].lateral < 0 ? 'L' : 'R';
+    if (reach == carry)
+      len += snprintf(buf + len, sizeof(buf) - len, "%s%.12s %c\n%d",
+                      i ? "\n" : "", hazardName(hz.type), side, reach);
+    else
+      len += snprintf(buf + len, sizeof(buf) - len, "%s%.12s %c\n%d / %d",
+                      i ? "\n" : "", hazardName(hz.type), side, reach, carry);
   }
+  setLabel(lblHazards_, buf);
 }
 
 void HolePage::gestureCb(lv_event_t* e) {
@@ -1,6 +1,10 @@
 #pragma once
 #include "Page.h"
 #include "CoursesManager.h"
+#include "TargetTable.h"
+#include "GreenOutline.h"
+#include "HoleIndex.h"
+#include "MotionGate.h"
 #include <lvgl.h>
 #include <algorithm>
 
@@ -10,6 +14,7 @@ public:
   void onCreate() override;
   void onDestroy() override;
   void onGpsUpdate(const GpsData& d) override;   // updates distances & spinner
+  void printStats(Print& out) const override;    // gate and label counters
 
 private:
   int courseIdx_;
@@ -20,7 +25,37 @@ private:
   lv_obj_t* lblMid_   = nullptr;
   lv_obj_t* lblBack_  = nullptr;
 
+  // hazards in play ahead: "reach / carry" per line
+  lv_obj_t* lblHazards_ = nullptr;
+  static constexpr size_t HAZARDS_SHOWN   = 3;
+  static constexpr float  HAZARD_CORRIDOR = 40.0f;   // m either side of the line
+
+  // current hole's targets in the course frame, rebuilt on navigateTo()
+  TargetTable targets_;
+  int tgtPin_   = -1;
+  int tgtFront_ = -1;
+  int tgtBack_  = -1;
+  GreenOutline green_;   // when the hole has one, front/back come from it
+
+  // distance work only once the player moves past the fix noise; shown
+  // values move only on a change bigger than the display step
+  MotionGate  gate_;
+  StickyValue shownFront_, shownMid_, shownBack_;
+  static constexpr float DISPLAY_BAND_M = 0.75f;
+  uint32_t lastSeq_    = 0;
+  uint32_t staleTicks_ = 0;
+
+  // follows the hole the player is on; a swipe holds until the next change
+  HoleIndex   holeIndex_;
+  HoleTracker tracker_;
+  int fenceSub_ = 0;   // stepping onto a tee votes for its hole
+
   void navigateTo(int newIdx);
+  void buildTargets(const Course& course, const Hole& hole);
+  void buildHoleIndex(const Course& course);
   void updateDistances(const GpsData& d);
+  void followHole(const GpsData& d);
+  void updateHazards(const Hole& hole);
+  void onFence(const FenceEvent& e);
   static void gestureCb(lv_event_t* e);
 };
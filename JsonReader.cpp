@@ -0,0 +1,219 @@
+#include "JsonReader.h"
+#include <stdlib.h>
+
+bool JsonReader::feed(const char* p, size_t n) {
+  for (size_t i = 0; i < n && !err_;) {
+    // on error offset_ stays on the byte at fault
+    if (!step(p[i]) || err_) continue;
+    ++i;
+    ++offset_;
+  }
+  return !err_;
+}
+
+bool JsonReader::finish() {
+  if (!err_ && lex_ == Lex::Number) endNumber();   // a bare top-level number
+  if (!err_ && (lex_ != Lex::None || want_ != Want::Done)) fail("unexpected end");
+  return !err_;
+}
+
+void JsonReader::push(char c) {
+  if (len_ == MAX_TOKEN) return fail("string or number too long");
+  tok_[len_++] = c;
+}
+
+void JsonReader::open(bool object) {
+  if (depth_ == MAX_DEPTH) return fail("nested too deep");
+  objects_ = (objects_ & ~(1u << depth_)) | uint32_t(object) << depth_;
+  ++depth_;
+  if (object) {
+    h_.beginObject();
+    want_ = Want::FirstKeyOrEnd;
+  } else {
+    h_.beginArray();
+    want_ = Want::FirstValueOrEnd;
+  }
+}
+
+void JsonReader::close() {
+  bool object = inObject();
+  --depth_;
+  if (object) h_.endObject();
+  else        h_.endArray();
+  endValue();
+}
+
+void JsonReader::endNumber() {
+  tok_[len_] = '\0';
+  char* end;
+  double v = strtod(tok_, &end);
+  lex_ = Lex::None;
+  if (end != tok_ + len_) {
+    offset_ = tokenAt_;        // blame the number, not what ended it
+    return fail("bad number");
+  }
+  h_.number(v);
+  endValue();
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool JsonReader::step(char c) {
+  switch (lex_) {
+    case Lex::String:
+      if (c == '"') {
+        tok_[len_] = '\0';
+        lex_ = Lex::None;
+        if (isKey_) {
+          h_.key(tok_, len_);
+          want_ = Want::Colon;
+        } else {
+          h_.string(tok_, len_);
+          endValue();
+        }
+      } else if (c == '\\') {
+        lex_ = Lex::Escape;
+      } else if (uint8_t(c) < 0x20) {
+        fail("control character in string");
+      } else {
+        push(c);
+      }
+      return true;
+
+    case Lex::Escape:
+      lex_ = Lex::String;
+      switch (c) {
+        case '"': case '\\': case '/': push(c); break;
+        case 'n': push('\n'); break;
+        case 't': push('\t'); break;
+        case 'r': push('\r'); break;
+        case 'b': push('\b'); break;
+        case 'f': push('\f'); break;
+        case 'u': lex_ = Lex::Unicode; hexLeft_ = 4; cp_ = 0; break;
+        default:  fail("bad escape");
+      }
+      return true;
+
+    case Lex::Unicode: {
+      int v = hexValue(c);
+      if (v < 0) {
+        fail("bad \\u escape");
+        return true;
+      }
+      cp_ = uint16_t(cp_ << 4 | v);
+      if (--hexLeft_) return true;
+      lex_ = Lex::String;
+      // BMP code point as UTF-8
+      if (cp_ < 0x80) {
+        push(char(cp_));
+      } else if (cp_ < 0x800) {
+        push(char(0xC0 | cp_ >> 6));
+        push(char(0x80 | (cp_ & 0x3F)));
+      } else {
+        push(char(0xE0 | cp_ >> 12));
+        push(char(0x80 | (cp_ >> 6 & 0x3F)));
+        push(char(0x80 | (cp_ & 0x3F)));
+      }
+      return true;
+    }
+
+    case Lex::Number:
+      if ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' ||
+          c == '+' || c == '-') {
+        push(c);
+        return true;
+      }
+      endNumber();
+      return false;    // `c` belongs to whatever follows
+
+    case Lex::Literal:
+      if (c != literal_[litPos_]) {
+        fail("bad literal");
+        return true;
+      }
+      if (literal_[++litPos_]) return true;
+      lex_ = Lex::None;
+      if      (literal_[0] == 't') h_.boolean(true);
+      else if (literal_[0] == 'f') h_.boolean(false);
+      else                         h_.null();
+      endValue();
+      return true;
+
+    case Lex::None:
+      break;
+  }
+
+  if (c == ' ' || c == '\t' || c == '\n' || c == '\r') return true;
+  return structural(c);
+}
+
+bool JsonReader::structural(char c) {
+  switch (want_) {
+    case Want::FirstValueOrEnd:
+      if (c == ']') {
+        close();
+        return true;
+      }
+      // fall through
+    case Want::Value:
+      if (c == '{' || c == '[') {
+        open(c == '{');
+      } else if (c == '"') {
+        lex_ = Lex::String;
+        isKey_ = false;
+        len_ = 0;
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        lex_ = Lex::Number;
+        tokenAt_ = offset_;
+        len_ = 0;
+        push(c);
+      } else if (c == 't' || c == 'f' || c == 'n') {
+        lex_ = Lex::Literal;
+        literal_ = c == 't' ? "true" : c == 'f' ? "false" : "null";
+        litPos_ = 1;
+      } else {
+        fail("unexpected character");
+      }
+      return true;
+
+    case Want::FirstKeyOrEnd:
+      if (c == '}') {
+        close();
+        return true;
+      }
+      // fall through
+    case Want::Key:
+      if (c != '"') {
+        fail("expected string");
+        return true;
+      }
+      lex_ = Lex::String;
+      isKey_ = true;
+      len_ = 0;
+      return true;
+
+    case Want::Colon:
+      if (c == ':') want_ = Want::Value;
+      else          fail("expected ':'");
+      return true;
+
+    case Want::CommaOrEnd:
+      if (c == ',')
+        want_ = inObject() ? Want::Key : Want::Value;
+      else if (c == (inObject() ? '}' : ']'))
+        close();
+      else
+        fail(inObject() ? "expected ',' or '}'" : "expected ',' or ']'");
+      return true;
+
+    case Want::Done:
+      fail("trailing data");
+      return true;
+  }
+  return true;
+}
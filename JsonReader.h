@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Streaming (SAX-style) JSON reader.
+///
+/// Bytes are pushed in chunks of any size, e.g. straight out of PROGMEM or
+/// an SD read buffer, and each value is reported to a Handler the moment
+/// it ends; nothing is kept but the nesting stack and the current string
+/// or number, so the working set is this object (under 300 bytes)
+/// whatever the document size.  No heap, no exceptions; builds unchanged
+/// on the host.
+class JsonReader {
+public:
+  class Handler {
+  public:
+    virtual ~Handler() = default;
+    virtual void beginObject() {}
+    virtual void endObject() {}
+    virtual void beginArray() {}
+    virtual void endArray() {}
+    /// Keys and strings are NUL-terminated and only valid for the call.
+    virtual void key(const char* /*s*/, size_t /*n*/) {}
+    virtual void string(const char* /*s*/, size_t /*n*/) {}
+    virtual void number(double /*v*/) {}
+    virtual void boolean(bool /*v*/) {}
+    virtual void null() {}
+  };
+
+  static constexpr size_t MAX_DEPTH = 32;
+  static constexpr size_t MAX_TOKEN = 255;   // longest string or number
+
+  explicit JsonReader(Handler& h) : h_(h) {}
+
+  /// Consume the next `n` bytes.  False once the document is in error;
+  /// later calls do nothing.
+  bool feed(const char* p, size_t n);
+
+  /// End of input: false if the document is in error or incomplete.
+  bool finish();
+
+  /// Stop with an error at the current byte, e.g. from a Handler that
+  /// found something it cannot use.
+  void fail(const char* what) {
+    if (!err_) err_ = what;
+  }
+
+  /// Bytes consumed so far; after an error, the offset of the byte at
+  /// fault.
+  size_t offset() const { return offset_; }
+  const char* error() const { return err_; }
+
+private:
+  enum class Lex : uint8_t { None, String, Escape, Unicode, Number, Literal };
+  enum class Want : uint8_t {
+    Value, FirstValueOrEnd, FirstKeyOrEnd, Key, Colon, CommaOrEnd, Done
+  };
+
+  bool step(char c);          // false: `c` was not consumed
+  bool structural(char c);
+  void push(char c);
+  void open(bool object);
+  void close();
+  void endValue() { want_ = depth_ ? Want::CommaOrEnd : Want::Done; }
+  void endNumber();
+  bool inObject() const { return objects_ >> (depth_ - 1) & 1; }
+
+  Handler&    h_;
+  const char* err_     = nullptr;
+  size_t      offset_  = 0;
+  size_t      tokenAt_ = 0;        // where the number being read starts
+  Lex         lex_     = Lex::None;
+  Want        want_    = Want::Value;
+  bool        isKey_   = false;
+  uint8_t     depth_   = 0;
+  uint32_t    objects_ = 0;        // bit d set: level d + 1 is an object
+  const char* literal_ = nullptr;  // "true" / "false" / "null" being matched
+  uint8_t     litPos_  = 0;
+  uint8_t     hexLeft_ = 0;
+  uint16_t    cp_      = 0;
+  uint16_t    len_     = 0;
+  char        tok_[MAX_TOKEN + 1];
+};
@@ -102,25 +102,18 @@ void LocationPage::onGpsUpdate(const GpsData& d) {
 void LocationPage::updateLabels(const GpsData& d) {
   // Raw
   if (d.fix) {
-    lv_label_set_text_fmt(lblRawLat_, "Lat: %.8f", d.lat);
-    lv_label_set_text_fmt(lblRawLon_, "Lon: %.8f", d.lon);
+    lv_label_set_text_fmt(lblRawLat_, "Lat: %.7f", geo::toDegrees(d.pos.lat));
+    lv_label_set_text_fmt(lblRawLon_, "Lon: %.7f", geo::toDegrees(d.pos.lon));
   } else {
     lv_label_set_text(lblRawLat_, "Lat: --");
     lv_label_set_text(lblRawLon_, "Lon: --");
   }
 
-  // EMA smoothing
-  if (d.fix && d.hdop > 0 && d.hdop <= 3.0f) {
-    if (!emaInit_) {
-      emaInit_ = true;
-      emaLat_ = d.lat;
-      emaLon_ = d.lon;
-    } else {
-      emaLat_ = alpha_ * d.lat + (1 - alpha_) * emaLat_;
-      emaLon_ = alpha_ * d.lon + (1 - alpha_) * emaLon_;
-    }
-    lv_label_set_text_fmt(lblSmLat_, "Lat: %.6f", emaLat_);
-    lv_label_set_text_fmt(lblSmLon_, "Lon: %.6f", emaLon_);
+  // Smoothed: rolling mean kept by GpsManager's fix history
+  const auto m = GpsManager::instance().fetchMotion();
+  if (d.fix && m.samples) {
+    lv_label_set_text_fmt(lblSmLat_, "Lat: %.6f", geo::toDegrees(m.mean.lat));
+    lv_label_set_text_fmt(lblSmLon_, "Lon: %.6f", geo::toDegrees(m.mean.lon));
   } else {
     lv_label_set_text(lblSmLat_, "Lat: --");
     lv_label_set_text(lblSmLon_, "Lon: --");
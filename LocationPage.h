@@ -25,11 +25,5 @@ private:
   lv_obj_t* lblHdop_     = nullptr;
   lv_obj_t* lblSats_     = nullptr;
 
-  // smoothing state
-  bool emaInit_          = false;
-  float emaLat_          = 0.0f;
-  float emaLon_          = 0.0f;
-  static constexpr float alpha_ = 0.2f;
-
   void updateLabels(const GpsData& d);
 };
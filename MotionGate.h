@@ -0,0 +1,64 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+#include "Geo.h"
+
+/// Lets a fix through only once the player has moved further than the fix
+/// noise, so pages don't redo distance work while someone stands over the
+/// ball.  The threshold scales with HDOP and is measured from the last
+/// fix that was let through, so slow walking still accumulates.
+class MotionGate {
+public:
+  static constexpr float M_PER_HDOP = 1.0f;   // ~consecutive-fix jitter
+  static constexpr float MIN_M      = 0.5f;
+  static constexpr float MAX_M      = 5.0f;
+
+  /// True (and `pos` becomes the new anchor) when `pos` is beyond the
+  /// threshold for `hdop`, or nothing has passed since reset().
+  bool pass(const geo::Vec2& pos, float hdop) {
+    float t = fminf(fmaxf(hdop * M_PER_HDOP, MIN_M), MAX_M);
+    float dx = pos.x - anchor_.x, dy = pos.y - anchor_.y;
+    if (armed_ && dx * dx + dy * dy < t * t) {
+      ++skipped_;
+      return false;
+    }
+    anchor_ = pos;
+    armed_  = true;
+    ++passed_;
+    return true;
+  }
+
+  /// Force the next fix through, e.g. after the targets changed.
+  void reset() { armed_ = false; }
+
+  uint32_t passed()  const { return passed_; }
+  uint32_t skipped() const { return skipped_; }
+
+private:
+  geo::Vec2 anchor_;
+  bool      armed_   = false;
+  uint32_t  passed_  = 0;
+  uint32_t  skipped_ = 0;
+};
+
+/// A displayed number that only follows its source once the source leaves
+/// a band around the shown value, so a reading hovering on a rounding
+/// boundary doesn't flicker between two labels.
+class StickyValue {
+public:
+  /// Feed a new reading; true when the shown value changed.
+  bool update(float v, float band) {
+    if (valid_ && fabsf(v - shown_) < band) return false;
+    shown_ = v;
+    valid_ = true;
+    return true;
+  }
+
+  void  reset()       { valid_ = false; }
+  float value() const { return shown_; }
+
+private:
+  float shown_ = 0.0f;
+  bool  valid_ = false;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Compile-time sizing for the GPS link, from the sentence mix the
+/// receiver is told to emit.  Bit positions follow the PMTK314 field order.
+namespace nmea {
+
+enum : uint32_t {
+  GLL = 1u << 0,
+  RMC = 1u << 1,
+  VTG = 1u << 2,
+  GGA = 1u << 3,
+  GSA = 1u << 4,
+  GSV = 1u << 5,
+  ZDA = 1u << 17,
+};
+
+/// What PMTK_SET_NMEA_OUTPUT_ALLDATA turns on.
+static constexpr uint32_t MIX_ALLDATA = GLL | RMC | VTG | GGA | GSA | GSV;
+
+/// Just what NmeaParser decodes.
+static constexpr uint32_t MIX_PARSED  = RMC | GGA;
+
+/// Spec maximum per sentence, including "$" and CR/LF.
+static constexpr uint32_t MAX_SENTENCE_BYTES = 82;
+
+/// GSV comes in up to 4 parts (12 channels, 4 satellites each).
+static constexpr uint32_t GSV_PARTS = 4;
+
+/// Worst-case bytes the receiver sends per fix epoch.
+constexpr uint32_t bytesPerEpoch(uint32_t mix) {
+  uint32_t sentences = 0;
+  for (uint32_t m = mix & ~GSV; m; m &= m - 1) ++sentences;
+  if (mix & GSV) sentences += GSV_PARTS;
+  return sentences * MAX_SENTENCE_BYTES;
+}
+
+constexpr size_t nextPow2(size_t n) {
+  size_t p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+/// Share of a UART's capacity (8N1: 10 bits per byte) taken by `mix` at
+/// `rateHz`, in tenths of a percent.
+constexpr uint32_t utilizationPermille(uint32_t mix, uint32_t rateHz,
+                                       uint32_t baud) {
+  return uint32_t(uint64_t(bytesPerEpoch(mix)) * 10 * rateHz * 1000 / baud);
+}
+
+/// Ring size that holds `epochs` worth of the mix without overrunning.
+constexpr size_t ringCapacity(uint32_t mix, uint32_t epochs = 2) {
+  return nextPow2(size_t(bytesPerEpoch(mix)) * epochs);
+}
+
+}  // namespace nmea
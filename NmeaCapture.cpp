@@ -0,0 +1,75 @@
+#include "NmeaCapture.h"
+#include "CaptureFormat.h"
+#include "SdCard.h"
+#include <SD_MMC.h>
+
+bool NmeaCapture::begin() {
+  if (running_) return true;
+  if (!sdcard::mount()) return false;
+
+  SD_MMC.mkdir("/nmea");
+  char path[24];
+  for (int i = 0; i < 10000; ++i) {
+    snprintf(path, sizeof(path), "/nmea/%04d.cap", i);
+    if (!SD_MMC.exists(path)) break;
+  }
+  file_ = SD_MMC.open(path, FILE_WRITE);
+  if (!file_) {
+    Serial.printf("Capture: cannot open %s\n", path);
+    return false;
+  }
+  file_.write(reinterpret_cast<const uint8_t*>(capture::MAGIC),
+              sizeof(capture::MAGIC));
+
+  xTaskCreate(writerTask, "nmeacap", 4096, this, 1, &task_);
+  running_ = true;
+  Serial.printf("Capture: logging to %s\n", path);
+  return true;
+}
+
+void NmeaCapture::append(uint32_t us, const uint8_t* data, size_t n) {
+  if (!running_.load(std::memory_order_relaxed) || !n) return;
+  size_t need = capture::HEADER_LEN + n;
+  if (need > BUF_SIZE) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Buffer* b = &bufs_[active_];
+  bool stale = b->len && millis() - firstMs_ > FLUSH_MS;
+  if ((b->len + need > BUF_SIZE || stale) && swap()) b = &bufs_[active_];
+  if (b->len + need > BUF_SIZE) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);   // writer behind
+    return;
+  }
+
+  if (!b->len) firstMs_ = millis();
+  capture::putHeader(b->data + b->len, us, uint16_t(n));
+  memcpy(b->data + b->len + capture::HEADER_LEN, data, n);
+  b->len += need;
+}
+
+// Hand the active buffer to the writer; false if it still owns the other.
+bool NmeaCapture::swap() {
+  if (pending_.load(std::memory_order_acquire) >= 0) return false;
+  pending_.store(int8_t(active_), std::memory_order_release);
+  active_ ^= 1;
+  bufs_[active_].len = 0;
+  xTaskNotifyGive(task_);
+  return true;
+}
+
+void NmeaCapture::writerTask(void* arg) {
+  auto self = static_cast<NmeaCapture*>(arg);
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    int8_t i = self->pending_.load(std::memory_order_acquire);
+    if (i < 0) continue;
+
+    Buffer& b = self->bufs_[i];
+    size_t n = self->file_.write(b.data, b.len);
+    self->file_.flush();
+    self->written_.fetch_add(n, std::memory_order_relaxed);
+    self->pending_.store(-1, std::memory_order_release);
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <atomic>
+
+/// Raw GPS byte-stream capture to SD, replayable with tools/nmea_replay.
+///
+/// The UART task appends timestamped chunks into one of two RAM buffers;
+/// when a buffer fills (or has aged FLUSH_MS) the buffers swap and a
+/// low-priority task writes the full one out.  append() never waits on the
+/// card — if the writer falls behind, chunks are dropped and counted.
+class NmeaCapture {
+public:
+  static NmeaCapture& instance() {
+    static NmeaCapture inst;
+    return inst;
+  }
+
+  /// Mount the card, open the next /nmea/NNNN.cap and start the writer.
+  bool begin();
+
+  /// Called from the UART task with each bulk read; never blocks.
+  void append(uint32_t us, const uint8_t* data, size_t n);
+
+  bool     active()  const { return running_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  uint32_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+  NmeaCapture() = default;
+
+  static constexpr size_t   BUF_SIZE = 4096;
+  static constexpr uint32_t FLUSH_MS = 2000;
+
+  struct Buffer {
+    uint8_t data[BUF_SIZE];
+    size_t  len = 0;
+  };
+
+  bool swap();
+  static void writerTask(void* arg);
+
+  Buffer   bufs_[2];
+  uint8_t  active_  = 0;       // producer-owned
+  uint32_t firstMs_ = 0;       // when the active buffer got its first byte
+  std::atomic<int8_t>   pending_{-1};   // buffer handed to the writer
+  std::atomic<bool>     running_{false};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> written_{0};
+  TaskHandle_t task_ = nullptr;
+  fs::File     file_;
+};
@@ -0,0 +1,219 @@
+#include "NmeaParser.h"
+
+static constexpr uint32_t POW10[] = {
+  1, 10, 100, 1000, 10000, 100000, 1000000, 10000000
+};
+static constexpr uint8_t MAX_FRAC = 7;
+
+static constexpr uint32_t packType(char a, char b, char c) {
+  return (uint32_t(uint8_t(a)) << 16) | (uint32_t(uint8_t(b)) << 8) | uint8_t(c);
+}
+
+static int8_t hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+NmeaParser::Sentence NmeaParser::feed(char c) {
+  // a '$' always starts over, whatever we were in the middle of
+  if (c == '$') {
+    if (state_ != State::Idle) ++truncated_;
+    state_ = State::Address;
+    type_  = Sentence::None;
+    len_   = 1;
+    field_ = 0;
+    sum_   = 0;
+    addr_  = 0;
+    cur_   = Staged{};
+    resetField();
+    return Sentence::None;
+  }
+  if (state_ == State::Idle) return Sentence::None;
+
+  if (++len_ > MAX_SENTENCE || c == '\r' || c == '\n') {
+    state_ = State::Idle;  // truncated or garbage
+    ++truncated_;
+    return Sentence::None;
+  }
+
+  switch (state_) {
+    case State::Address:
+      if (c == ',') {
+        if      (addr_ == packType('G', 'G', 'A')) type_ = Sentence::GGA;
+        else if (addr_ == packType('R', 'M', 'C')) type_ = Sentence::RMC;
+        else if (addr_ == packType('0', '0', '1')) type_ = Sentence::Ack;
+        else                                       type_ = Sentence::Other;
+        sum_ ^= uint8_t(c);
+        field_ = 1;
+        state_ = State::Fields;
+      } else if (c == '*') {
+        state_ = State::Idle;
+        ++truncated_;
+      } else {
+        sum_ ^= uint8_t(c);
+        addr_ = ((addr_ << 8) | uint8_t(c)) & 0xFFFFFF;
+      }
+      break;
+
+    case State::Fields:
+      if (c == '*') {
+        endField();
+        state_ = State::Sum1;
+        break;
+      }
+      sum_ ^= uint8_t(c);
+      if (c == ',') {
+        endField();
+        ++field_;
+        resetField();
+      } else if (type_ != Sentence::Other) {
+        if (empty_) { first_ = c; empty_ = false; }
+        if (c >= '0' && c <= '9') {
+          if (!inFrac_) {
+            intPart_ = intPart_ * 10 + uint32_t(c - '0');
+          } else if (fracDigits_ < MAX_FRAC) {
+            frac_ = frac_ * 10 + uint32_t(c - '0');
+            ++fracDigits_;
+          }
+        } else if (c == '.') {
+          inFrac_ = true;
+        }
+      }
+      break;
+
+    case State::Sum1: {
+      int8_t v = hexValue(c);
+      if (v < 0) { state_ = State::Idle; ++truncated_; break; }
+      rxSum_ = uint8_t(v) << 4;
+      state_ = State::Sum2;
+      break;
+    }
+
+    case State::Sum2: {
+      int8_t v = hexValue(c);
+      state_ = State::Idle;
+      if (v < 0 || uint8_t(rxSum_ | v) != sum_) {
+        ++checksumErrors_;
+        break;
+      }
+      if (type_ == Sentence::GGA || type_ == Sentence::RMC) {
+        done_ = cur_;
+        last_ = type_;
+      } else if (type_ == Sentence::Ack) {
+        ackCmd_  = cur_.ackCmd;
+        ackFlag_ = cur_.ackFlag;
+      }
+      return type_;
+    }
+
+    default:
+      break;
+  }
+  return Sentence::None;
+}
+
+void NmeaParser::apply(GpsData& d) const {
+  const Staged& s = done_;
+  // empty fields (no fix yet) leave the previous values alone
+  if (s.hasTime) {
+    d.hour   = s.time / 10000;
+    d.minute = (s.time / 100) % 100;
+    d.second = s.time % 100;
+    d.millis = s.millis;
+  }
+  if (s.hasPos) {
+    d.pos.lat = s.latE7;
+    d.pos.lon = s.lonE7;
+  }
+
+  if (last_ == Sentence::GGA) {
+    d.fixQuality = s.quality;
+    d.fix        = s.quality > 0;
+    d.sats       = s.sats;
+    d.hdop       = s.hdop;
+    d.altitude   = s.altitude;
+  } else if (last_ == Sentence::RMC) {
+    d.fix        = s.active;
+    d.speedKnots = s.speed;
+    d.trackAngle = s.track;
+    if (s.date) {
+      d.day      = s.date / 10000;
+      d.month    = (s.date / 100) % 100;
+      d.year     = 2000 + s.date % 100;
+    }
+  }
+}
+
+uint32_t NmeaParser::utcKey() const {
+  return done_.hasTime ? done_.time * 1000 + done_.millis : NO_TIME;
+}
+
+void NmeaParser::resetField() {
+  intPart_    = 0;
+  frac_       = 0;
+  fracDigits_ = 0;
+  inFrac_     = false;
+  empty_      = true;
+  first_      = 0;
+}
+
+float NmeaParser::fieldFloat() const {
+  float v = float(intPart_) + float(frac_) / float(POW10[fracDigits_]);
+  return first_ == '-' ? -v : v;
+}
+
+void NmeaParser::setTime() {
+  // hhmmss.sss; fraction scaled to milliseconds
+  cur_.time    = intPart_;
+  cur_.millis  = fracDigits_ <= 3
+               ? uint16_t(frac_ * POW10[3 - fracDigits_])
+               : uint16_t(frac_ / POW10[fracDigits_ - 3]);
+  cur_.hasTime = true;
+}
+
+int32_t NmeaParser::fieldAngleE7() const {
+  // ddmm.mmmm: whole degrees, then minutes scaled to 1e-7 degree
+  int64_t minutesE7 = int64_t(intPart_ % 100) * POW10[MAX_FRAC]
+                    + int64_t(frac_) * POW10[MAX_FRAC - fracDigits_];
+  return int32_t((intPart_ / 100) * POW10[MAX_FRAC] + (minutesE7 + 30) / 60);
+}
+
+// Field indices follow NMEA-0183: GGA time,lat,N,lon,E,quality,sats,hdop,alt
+// and RMC time,status,lat,N,lon,E,speed,track,date; PMTK001 is cmd,flag.
+void NmeaParser::endField() {
+  if (empty_ || type_ == Sentence::Other) return;
+  Staged& s = cur_;
+
+  if (type_ == Sentence::Ack) {
+    if      (field_ == 1) s.ackCmd  = uint16_t(intPart_);
+    else if (field_ == 2) s.ackFlag = uint8_t(intPart_);
+  } else if (type_ == Sentence::GGA) {
+    switch (field_) {
+      case 1: setTime();                               break;
+      case 2: s.latE7 = fieldAngleE7(); s.hasPos = true; break;
+      case 3: if (first_ == 'S') s.latE7 = -s.latE7;   break;
+      case 4: s.lonE7 = fieldAngleE7();                break;
+      case 5: if (first_ == 'W') s.lonE7 = -s.lonE7;   break;
+      case 6: s.quality = uint8_t(intPart_);           break;
+      case 7: s.sats = uint8_t(intPart_);              break;
+      case 8: s.hdop = fieldFloat();                   break;
+      case 9: s.altitude = fieldFloat();               break;
+      default:                                         break;
+    }
+  } else {
+    switch (field_) {
+      case 1: setTime();                               break;
+      case 2: s.active = first_ == 'A';                break;
+      case 3: s.latE7 = fieldAngleE7(); s.hasPos = true; break;
+      case 4: if (first_ == 'S') s.latE7 = -s.latE7;   break;
+      case 5: s.lonE7 = fieldAngleE7();                break;
+      case 6: if (first_ == 'W') s.lonE7 = -s.lonE7;   break;
+      case 7: s.speed = fieldFloat();                  break;
+      case 8: s.track = fieldFloat();                  break;
+      case 9: s.date = intPart_;                       break;
+      default:                                         break;
+    }
+  }
+}
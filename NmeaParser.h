@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdint.h>
+#include "GpsData.h"
+
+/// Incremental NMEA-0183 tokenizer.
+///
+/// Bytes are fed one at a time as they come off the UART.  GGA and RMC
+/// fields are decoded into numeric accumulators while they stream past, and
+/// the checksum is folded in on the same pass, so a sentence is never
+/// buffered, copied or re-scanned.  No heap, no libc string calls — this
+/// header builds unchanged on the host.
+class NmeaParser {
+public:
+  enum class Sentence : uint8_t { None, GGA, RMC, Ack, Other };
+
+  /// Consume one byte.  Returns the sentence type once a complete sentence
+  /// with a valid checksum has been seen, otherwise Sentence::None.
+  Sentence feed(char c);
+
+  /// Copy the fields carried by the last accepted GGA/RMC into `d`.
+  void apply(GpsData& d) const;
+
+  /// UTC time of the last accepted GGA/RMC as hhmmss * 1000 + ms, or
+  /// NO_TIME if the field was empty.  Keys sentences to a receiver epoch.
+  uint32_t utcKey() const;
+  static constexpr uint32_t NO_TIME = 0xFFFFFFFF;
+
+  /// Sentence type of the last accepted sentence: the three characters
+  /// after the talker ID, packed big-endian ('G','G','A' → 0x474741).
+  uint32_t type() const { return addr_; }
+
+  /// Sentences dropped on a bad checksum, or cut short ('$' or CR/LF
+  /// before the checksum, or longer than MAX_SENTENCE).
+  uint32_t checksumErrors() const { return checksumErrors_; }
+  uint32_t truncated()      const { return truncated_; }
+
+  /// Command number and flag (3 = success) of the last PMTK001 ack.
+  uint16_t ackCommand() const { return ackCmd_; }
+  uint8_t  ackFlag()    const { return ackFlag_; }
+
+  /// Longest sentence the spec allows, including '$' and "*hh".
+  static constexpr uint8_t MAX_SENTENCE = 82;
+
+private:
+  enum class State : uint8_t { Idle, Address, Fields, Sum1, Sum2 };
+
+  // fields of the sentence currently being tokenized
+  struct Staged {
+    uint32_t time      = 0;     // hhmmss
+    uint16_t millis    = 0;
+    uint32_t date      = 0;     // ddmmyy
+    int32_t  latE7     = 0;
+    int32_t  lonE7     = 0;
+    float    hdop      = 99.0f;
+    float    altitude  = 0.0f;
+    float    speed     = 0.0f;
+    float    track     = 0.0f;
+    uint8_t  quality   = 0;
+    uint8_t  sats      = 0;
+    bool     active    = false; // RMC status 'A'
+    bool     hasTime   = false;
+    bool     hasPos    = false;
+    uint16_t ackCmd    = 0;
+    uint8_t  ackFlag   = 0;
+  };
+
+  void resetField();
+  void endField();
+  void setTime();
+  float fieldFloat() const;
+  int32_t fieldAngleE7() const;  // (d)ddmm.mmmm → degrees * 1e7
+
+  State    state_    = State::Idle;
+  Sentence type_     = Sentence::None;
+  Sentence last_     = Sentence::None;
+  uint8_t  len_      = 0;
+  uint8_t  field_    = 0;
+  uint8_t  sum_      = 0;
+  uint8_t  rxSum_    = 0;
+  uint32_t addr_     = 0;        // last 3 chars of the address, packed
+
+  // per-field accumulators
+  uint32_t intPart_  = 0;
+  uint32_t frac_     = 0;
+  uint8_t  fracDigits_ = 0;
+  bool     inFrac_   = false;
+  bool     empty_    = true;
+  char     first_    = 0;
+
+  Staged   cur_;
+  Staged   done_;
+  uint16_t ackCmd_   = 0;
+  uint8_t  ackFlag_  = 0;
+  uint32_t checksumErrors_ = 0;
+  uint32_t truncated_      = 0;
+};
@@ -0,0 +1,64 @@
+#include "NmeaStats.h"
+
+void NmeaStats::countSentence(uint32_t id) {
+  for (Type& t : types) {
+    if (t.id == id) { ++t.count; return; }
+    if (!t.id)      { t.id = id; t.count = 1; return; }
+  }
+  ++otherTypes;
+}
+
+void NmeaStats::countParse(uint32_t us) {
+  size_t b = 0;
+  while (b + 1 < HIST_BUCKETS && us >= (2u << b)) ++b;
+  ++parseUs[b];
+}
+
+void NmeaStats::roll(uint32_t nowMs) {
+  uint32_t dt = nowMs - uptimeMs;
+  uptimeMs = nowMs;
+  if (!dt) return;
+  for (Type& t : types) {
+    if (!t.id) break;
+    uint32_t instant = (t.count - t.base) * 100000u / dt;
+    t.rateCentiHz = uint16_t((t.rateCentiHz * 3u + instant) / 4u);
+    t.base = t.count;
+  }
+}
+
+// Frame layout (all little-endian):
+//   'G' 'S' version=1 nTypes
+//   u32 uptimeMs
+//   u32 otherTypes checksumErrors truncated ringOverruns uartErrors
+//       ringHighWater ringCapacity
+//   nTypes x { char[3] type, u32 count, u16 rateCentiHz }
+//   HIST_BUCKETS x u32 parseUs
+//   u8 xor of everything before it
+size_t NmeaStats::serialize(uint8_t* out, size_t cap) const {
+  if (cap < SERIALIZED_MAX) return 0;
+  uint8_t* p = out;
+  auto u8  = [&](uint8_t v)  { *p++ = v; };
+  auto u16 = [&](uint16_t v) { u8(uint8_t(v)); u8(uint8_t(v >> 8)); };
+  auto u32 = [&](uint32_t v) { u16(uint16_t(v)); u16(uint16_t(v >> 16)); };
+
+  uint8_t n = 0;
+  while (n < MAX_TYPES && types[n].id) ++n;
+
+  u8('G'); u8('S'); u8(1); u8(n);
+  u32(uptimeMs);
+  u32(otherTypes); u32(checksumErrors); u32(truncated);
+  u32(ringOverruns); u32(uartErrors); u32(ringHighWater); u32(ringCapacity);
+  for (uint8_t i = 0; i < n; ++i) {
+    u8(uint8_t(types[i].id >> 16));
+    u8(uint8_t(types[i].id >> 8));
+    u8(uint8_t(types[i].id));
+    u32(types[i].count);
+    u16(types[i].rateCentiHz);
+  }
+  for (uint32_t h : parseUs) u32(h);
+
+  uint8_t sum = 0;
+  for (uint8_t* q = out; q < p; ++q) sum ^= *q;
+  u8(sum);
+  return size_t(p - out);
+}
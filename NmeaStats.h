@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// GPS link health: per-sentence counts and rates, error counters and a
+/// parse-time histogram.  Plain data so it can be published through a
+/// Seqlock and serialized for the binary Serial dump.
+struct NmeaStats {
+  static constexpr size_t MAX_TYPES    = 12;
+  static constexpr size_t HIST_BUCKETS = 12;   // bucket i: < 2^(i+1) us
+
+  struct Type {
+    uint32_t id          = 0;   // NmeaParser::type(), 0 = unused slot
+    uint32_t count       = 0;
+    uint32_t base        = 0;   // count at the last roll()
+    uint16_t rateCentiHz = 0;   // sentences per second * 100, smoothed
+  };
+
+  uint32_t uptimeMs       = 0;
+  Type     types[MAX_TYPES];
+  uint32_t otherTypes     = 0;  // sentences once the table is full
+  uint32_t checksumErrors = 0;
+  uint32_t truncated      = 0;
+  uint32_t ringOverruns   = 0;  // bytes dropped, RX ring full
+  uint32_t uartErrors     = 0;  // FIFO / driver-buffer overflow events
+  uint32_t ringHighWater  = 0;
+  uint32_t ringCapacity   = 0;
+  uint32_t parseUs[HIST_BUCKETS] = {};
+
+  void countSentence(uint32_t id);
+  void countParse(uint32_t us);
+
+  /// Turn counts since the last call into per-type rates.
+  void roll(uint32_t nowMs);
+
+  /// Compact little-endian frame, see NmeaStats.cpp.  Returns the length
+  /// written, or 0 if `cap` is too small.
+  size_t serialize(uint8_t* out, size_t cap) const;
+
+  static constexpr size_t SERIALIZED_MAX =
+    4 + 4 + 7 * 4 + MAX_TYPES * 9 + HIST_BUCKETS * 4 + 1;
+};
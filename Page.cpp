@@ -21,6 +21,17 @@ void Page::onDestroy() {
   }
 }
 
+bool Page::setLabel(lv_obj_t* lbl, const char* text) {
+  if (strcmp(lv_label_get_text(lbl), text) == 0) {
+    ++labelSkips_;
+    pxSkipped_ += uint32_t(lv_obj_get_width(lbl)) * lv_obj_get_height(lbl);
+    return false;
+  }
+  lv_label_set_text(lbl, text);
+  ++labelWrites_;
+  return true;
+}
+
 void Page::createBase(const char* title, bool canGoBack) {
   // ─── full-screen black background ─────────────────────────────────
   scr_ = lv_obj_create(nullptr);
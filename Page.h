@@ -11,12 +11,25 @@ public:
   /** Pages override this to update their own labels. */
   virtual void onGpsUpdate(const GpsData& d) { /* no-op */ }
 
+  /** Text counters for the console's 's' dump; most pages have none. */
+  virtual void printStats(Print& out) const { /* no-op */ }
+
 protected:
   lv_obj_t* scr_       = nullptr;
   lv_obj_t* ledStatus_ = nullptr;
   lv_timer_t* gpsTimer_ = nullptr;  // <— new
   lv_obj_t* hdrLabel_ = nullptr;
 
+  // label writes that changed the text vs. ones skipped as identical,
+  // and the label area those skips kept LVGL from redrawing
+  uint32_t labelWrites_ = 0;
+  uint32_t labelSkips_  = 0;
+  uint32_t pxSkipped_   = 0;
+
+  /// lv_label_set_text() only when the text differs; every set_text
+  /// invalidates the label even if nothing changed.  True when written.
+  bool setLabel(lv_obj_t* lbl, const char* text);
+
   void createBase(const char* title, bool canGoBack);
   static void backEventCallback(lv_event_t* e);
   static void swipeEventCallback(lv_event_t* e);
@@ -16,6 +16,9 @@ public:
   /// Pop current page: show previous, then destroy the top one.
   void popPage();
 
+  /// The page on screen, or nullptr before the first push.
+  Page* current() const { return stack_.empty() ? nullptr : stack_.back(); }
+
 private:
   PageManager() = default;
   std::vector<Page*> stack_;
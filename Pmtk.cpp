@@ -0,0 +1,70 @@
+#include "Pmtk.h"
+#include <stdio.h>
+
+namespace pmtk {
+
+size_t frame(char* out, size_t cap, const char* body) {
+  uint8_t sum = 0;
+  for (const char* c = body; *c; ++c) sum ^= uint8_t(*c);
+  int n = snprintf(out, cap, "$%s*%02X", body, sum);
+  return (n > 0 && size_t(n) < cap) ? size_t(n) : 0;
+}
+
+size_t test(char* out, size_t cap) {
+  return frame(out, cap, "PMTK000");
+}
+
+size_t setBaud(char* out, size_t cap, uint32_t baud) {
+  char body[24];
+  snprintf(body, sizeof(body), "PMTK251,%lu", (unsigned long)baud);
+  return frame(out, cap, body);
+}
+
+size_t setRate(char* out, size_t cap, uint32_t hz) {
+  char body[24];
+  snprintf(body, sizeof(body), "PMTK220,%lu", (unsigned long)(1000 / hz));
+  return frame(out, cap, body);
+}
+
+size_t setOutput(char* out, size_t cap, uint32_t mix) {
+  // 19 fields in PMTK314 order; bit i of the mix drives field i
+  char body[8 + 19 * 2];
+  char* p = body + snprintf(body, sizeof(body), "PMTK314");
+  for (int i = 0; i < 19; ++i) {
+    *p++ = ',';
+    *p++ = (mix >> i) & 1 ? '1' : '0';
+  }
+  *p = '\0';
+  return frame(out, cap, body);
+}
+
+size_t setTime(char* out, size_t cap, const UtcTime& t) {
+  char body[48];
+  snprintf(body, sizeof(body), "PMTK740,%u,%u,%u,%u,%u,%u",
+           t.year, t.month, t.day, t.hour, t.minute, t.second);
+  return frame(out, cap, body);
+}
+
+// Fixed point straight to "-25.8838700"; no floating point involved
+static int formatE7(char* out, size_t cap, int32_t e7) {
+  uint32_t a = e7 < 0 ? uint32_t(-int64_t(e7)) : uint32_t(e7);
+  return snprintf(out, cap, "%s%lu.%07lu", e7 < 0 ? "-" : "",
+                  (unsigned long)(a / 10000000), (unsigned long)(a % 10000000));
+}
+
+size_t setPosition(char* out, size_t cap, const Geo& pos, int16_t altM,
+                   const UtcTime& t) {
+  char lat[16], lon[16], body[96];
+  formatE7(lat, sizeof(lat), pos.lat);
+  formatE7(lon, sizeof(lon), pos.lon);
+  snprintf(body, sizeof(body), "PMTK741,%s,%s,%d,%u,%u,%u,%u,%u,%u",
+           lat, lon, altM,
+           t.year, t.month, t.day, t.hour, t.minute, t.second);
+  return frame(out, cap, body);
+}
+
+size_t binaryMode(char* out, size_t cap) {
+  return frame(out, cap, "PMTK253,1,0");
+}
+
+}  // namespace pmtk
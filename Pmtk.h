@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Geo.h"
+
+/// Builders for the MTK configuration sentences.  Each writes a complete
+/// "$PMTK...*hh" (no CR/LF) into `out` and returns its length, or 0 if it
+/// does not fit.
+namespace pmtk {
+
+/// Wrap `body` (without '$') as "$body*hh".
+size_t frame(char* out, size_t cap, const char* body);
+
+/// PMTK000: no-op, acked — used to probe the link.
+size_t test(char* out, size_t cap);
+
+/// PMTK251: switch the receiver's UART baud rate.  Not acked.
+size_t setBaud(char* out, size_t cap, uint32_t baud);
+
+/// PMTK220: fix interval for `hz` fixes per second.
+size_t setRate(char* out, size_t cap, uint32_t hz);
+
+/// PMTK314: emit exactly the sentences in `mix` (see NmeaBudget.h), once
+/// per fix.
+size_t setOutput(char* out, size_t cap, uint32_t mix);
+
+/// UTC date/time as the aiding commands want it.
+struct UtcTime {
+  uint16_t year;
+  uint8_t  month, day, hour, minute, second;
+};
+
+/// PMTK740: inject current UTC time.
+size_t setTime(char* out, size_t cap, const UtcTime& t);
+
+/// PMTK741: inject a reference position (and the UTC time it holds at).
+size_t setPosition(char* out, size_t cap, const Geo& pos, int16_t altM,
+                   const UtcTime& t);
+
+/// PMTK253: switch the port to MTK binary (EPO upload) mode.
+size_t binaryMode(char* out, size_t cap);
+
+}  // namespace pmtk
@@ -0,0 +1,20 @@
+#include "SdCard.h"
+#include <Arduino.h>
+#include <SD_MMC.h>
+#include "pin_config.h"  // SDMMC_CLK / CMD / DATA
+
+namespace sdcard {
+
+bool mount() {
+  static bool tried   = false;
+  static bool mounted = false;
+  if (tried) return mounted;
+  tried = true;
+
+  SD_MMC.setPins(SDMMC_CLK, SDMMC_CMD, SDMMC_DATA);
+  mounted = SD_MMC.begin("/sdcard", /*mode1bit=*/true);
+  if (!mounted) Serial.println("SD: no card");
+  return mounted;
+}
+
+}  // namespace sdcard
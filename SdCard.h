@@ -0,0 +1,9 @@
+#pragma once
+
+/// Shared SDMMC mount (1-bit bus on the SDMMC_* pins).
+namespace sdcard {
+
+/// Mount once; later calls just report whether the card is there.
+bool mount();
+
+}  // namespace sdcard
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+
+/// Single-writer, multi-reader publication of a small POD.
+///
+/// The writer never waits and readers never block it: a reader that races a
+/// store simply retries.  The payload lives in relaxed 32-bit atomics so the
+/// concurrent copy is well-defined on both ESP32 cores and on the host.
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Seqlock payload must be trivially copyable");
+
+public:
+  /// Publish a new value.  Only one thread may call this.
+  void store(const T& v) {
+    uint32_t buf[WORDS] = {};
+    memcpy(buf, &v, sizeof(T));
+
+    uint32_t s = seq_.load(std::memory_order_relaxed);
+    seq_.store(s + 1, std::memory_order_relaxed);   // odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i)
+      words_[i].store(buf[i], std::memory_order_relaxed);
+    seq_.store(s + 2, std::memory_order_release);
+  }
+
+  /// Take a consistent snapshot; safe from any thread.
+  T load() const {
+    uint32_t buf[WORDS];
+    uint32_t before, after;
+    do {
+      before = seq_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < WORDS; ++i)
+        buf[i] = words_[i].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = seq_.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+
+    T out;
+    memcpy(&out, buf, sizeof(T));
+    return out;
+  }
+
+  /// Number of completed stores.
+  uint32_t version() const {
+    return seq_.load(std::memory_order_acquire) >> 1;
+  }
+
+private:
+  static constexpr size_t WORDS = (sizeof(T) + 3) / 4;
+
+  std::atomic<uint32_t> seq_{0};
+  std::atomic<uint32_t> words_[WORDS] = {};
+};
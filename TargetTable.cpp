@@ -0,0 +1,97 @@
+#include "TargetTable.h"
+#include <math.h>
+#include <algorithm>
+#include "FastMath.h"
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static constexpr float DEG_PER_RAD = float(180.0 / M_PI);
+
+int TargetTable::add(TargetKind kind, const geo::Vec2& pos, uint8_t ref,
+                     float radius) {
+  if (n_ >= MAX_TARGETS) return -1;
+  x_[n_]      = pos.x;
+  y_[n_]      = pos.y;
+  kind_[n_]   = kind;
+  ref_[n_]    = ref;
+  radius_[n_] = radius;
+  return int(n_++);
+}
+
+int TargetTable::find(TargetKind kind) const {
+  for (size_t i = 0; i < n_; ++i)
+    if (kind_[i] == kind) return int(i);
+  return -1;
+}
+
+void TargetTable::solve(const geo::Vec2& from, const geo::LocalFrame& frame) {
+  // offsets first, at the scale of each pair's mid-latitude; straight-line
+  // multiply-adds the compiler vectorizes as is
+  const float sx = frame.xSlope(), sy = frame.ySlope();
+  for (size_t i = 0; i < n_; ++i) {
+    float m = 0.5f * (y_[i] + from.y);
+    dx_[i] = (x_[i] - from.x) * (1.0f + sx * m);
+    dy_[i] = (y_[i] - from.y) * (1.0f + sy * m);
+  }
+
+  size_t i = 0;
+#if defined(__SSE__)
+  for (; i + 4 <= n_; i += 4) {
+    __m128 x = _mm_load_ps(dx_ + i);
+    __m128 y = _mm_load_ps(dy_ + i);
+    _mm_store_ps(dist_ + i,
+                 _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; i + 4 <= n_; i += 4) {
+    float32x4_t x = vld1q_f32(dx_ + i);
+    float32x4_t y = vld1q_f32(dy_ + i);
+    vst1q_f32(dist_ + i, vsqrtq_f32(vmlaq_f32(vmulq_f32(x, x), y, y)));
+  }
+#endif
+  // ESP32-S3's PIE lanes are integer-only, so on device this loop is it
+  for (; i < n_; ++i)
+    dist_[i] = sqrtf(dx_[i] * dx_[i] + dy_[i] * dy_[i]);
+
+  for (size_t k = 0; k < n_; ++k) {
+    // 1.2e-5 rad is well under the whole degrees shown
+    float b = fm::atan2<fm::Tier::Mid>(dx_[k], dy_[k]) * DEG_PER_RAD;
+    // a hair west of north rounds to 360 in float; that is north
+    b = b < 0.0f ? b + 360.0f : b;
+    bearing_[k] = b < 360.0f ? b : 0.0f;
+  }
+}
+
+size_t TargetTable::ahead(int line, TargetKind kind, float corridor,
+                          TargetAhead* out, size_t k) const {
+  if (line < 0 || size_t(line) >= n_ || dist_[line] <= 0.0f || !k) return 0;
+
+  // unit vector along the line of play; the offsets are already in dx_/dy_
+  const float len = dist_[line];
+  const float ux = dx_[line] / len, uy = dy_[line] / len;
+
+  TargetAhead cand[MAX_TARGETS];
+  size_t m = 0;
+  for (size_t i = 0; i < n_; ++i) {
+    if (kind_[i] != kind) continue;
+    float along   = dx_[i] * ux + dy_[i] * uy;
+    float lateral = dx_[i] * uy - dy_[i] * ux;
+    float r = radius_[i];
+    if (along + r <= 0.0f || along - r >= len) continue;   // behind / past it
+    if (fabsf(lateral) - r > corridor) continue;
+    cand[m++] = TargetAhead{ uint8_t(i), along - r, along + r, lateral };
+  }
+
+  // only the first k need ordering
+  size_t take = m < k ? m : k;
+  std::partial_sort(cand, cand + take, cand + m,
+                    [](const TargetAhead& a, const TargetAhead& b) {
+                      return a.reach < b.reach;
+                    });
+  std::copy(cand, cand + take, out);
+  return take;
+}
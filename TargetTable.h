@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Geo.h"
+
+enum class TargetKind : uint8_t { Pin, Front, Back, Hazard, Layup };
+
+/// A target projected onto the player's line to another target.
+struct TargetAhead {
+  uint8_t slot;
+  float   reach;     // m along the line to its near edge
+  float   carry;     // m along the line to clear its far edge
+  float   lateral;   // m off the line, positive to the right
+};
+
+/// Every point worth a distance on one hole, stored structure-of-arrays in
+/// the course's local frame.  solve() updates distance and bearing to all
+/// of them in one pass; the distance loop runs four lanes at a time on
+/// SSE / NEON hosts and on the FPU elsewhere.
+class TargetTable {
+public:
+  static constexpr size_t MAX_TARGETS = 64;
+
+  void clear() { n_ = 0; }
+
+  /// Append a target; `ref` links back to e.g. the hazard index and
+  /// `radius` (m) gives it an extent along the line of play.  Returns its
+  /// slot, or -1 when full.
+  int add(TargetKind kind, const geo::Vec2& pos, uint8_t ref = 0,
+          float radius = 0.0f);
+
+  size_t size() const { return n_; }
+
+  /// First slot of `kind`, or -1.
+  int find(TargetKind kind) const;
+
+  /// Recompute all distances (m) and bearings (deg from north, clockwise)
+  /// from `from`, with offsets rescaled as `frame`.delta() would.
+  void solve(const geo::Vec2& from, const geo::LocalFrame& frame);
+
+  /// After solve(): targets of `kind` in play between the player and slot
+  /// `line` and within `corridor` m of that line, nearest reach first.
+  /// Writes at most `k` to `out` and returns how many.
+  size_t ahead(int line, TargetKind kind, float corridor,
+               TargetAhead* out, size_t k) const;
+
+  TargetKind kind(size_t i)     const { return kind_[i]; }
+  uint8_t    ref(size_t i)      const { return ref_[i]; }
+  geo::Vec2  position(size_t i) const { return geo::Vec2{ x_[i], y_[i] }; }
+  float      radius(size_t i)   const { return radius_[i]; }
+  float      distance(size_t i) const { return dist_[i]; }
+  float      bearing(size_t i)  const { return bearing_[i]; }
+
+private:
+  alignas(16) float x_[MAX_TARGETS];
+  alignas(16) float y_[MAX_TARGETS];
+  alignas(16) float dx_[MAX_TARGETS];
+  alignas(16) float dy_[MAX_TARGETS];
+  alignas(16) float dist_[MAX_TARGETS];
+  float      bearing_[MAX_TARGETS];
+  float      radius_[MAX_TARGETS];
+  TargetKind kind_[MAX_TARGETS];
+  uint8_t    ref_[MAX_TARGETS];
+  size_t     n_ = 0;
+};
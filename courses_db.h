@@ -0,0 +1,135 @@
+// courses_db.h — generated by tools/course_compiler from courses_data.h.
+// Do not edit; rerun the compiler after changing the course JSON.
+//
+// The course image (CourseImage.h) built into the firmware, for when the
+// "courses" flash partition holds none.
+#pragma once
+
+#include <stdint.h>
+
+namespace coursedb {
+
+alignas(4) static const uint8_t IMAGE[1916] = {
+  0x47, 0x43, 0x44, 0x42, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x84, 0x00, 0x00, 0x00, 0x7c, 0x07, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x72, 0x07, 0x00, 0x00,
+  0x52, 0x15, 0x94, 0xf0, 0x8a, 0xb8, 0xcf, 0x10, 0xac, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x01, 0x00, 0x00, 0x00,
+  0x22, 0x83, 0x35, 0x3c, 0x35, 0x30, 0x24, 0x3c, 0x2b, 0x4c, 0xa3, 0x33, 0x06, 0x06, 0xab, 0xb0,
+  0x6c, 0x07, 0x00, 0x00, 0x54, 0x6f, 0x92, 0xf0, 0xe0, 0x87, 0xd2, 0x10, 0x0c, 0x04, 0x00, 0x00,
+  0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8f, 0x78, 0x92, 0xf0, 0xd3, 0xdb, 0xd1, 0x10,
+  0x01, 0x00, 0x00, 0x00, 0x1b, 0x83, 0x35, 0x3c, 0xb3, 0x31, 0x24, 0x3c, 0x59, 0x44, 0xa3, 0x33,
+  0xf6, 0x00, 0xab, 0xb0, 0x57, 0xfd, 0x4a, 0x3f, 0x81, 0xba, 0xd9, 0x3e, 0x0e, 0x6d, 0xdf, 0xbe,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0xef, 0x4a, 0x3f, 0xcd, 0xd6, 0xd9, 0x3e,
+  0x4a, 0x83, 0xdf, 0xbe, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xfe, 0x18, 0x94, 0xf0, 0xde, 0xb9, 0xcf, 0x10,
+  0x2a, 0x1a, 0x94, 0xf0, 0x16, 0xb9, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x54, 0x18, 0x94, 0xf0, 0x0a, 0xbb, 0xcf, 0x10,
+  0x80, 0x19, 0x94, 0xf0, 0x42, 0xba, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x46, 0x17, 0x94, 0xf0, 0xf0, 0xbb, 0xcf, 0x10,
+  0x72, 0x18, 0x94, 0xf0, 0x28, 0xbb, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xfc, 0x15, 0x94, 0xf0, 0x5e, 0xbc, 0xcf, 0x10,
+  0x28, 0x17, 0x94, 0xf0, 0x96, 0xbb, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xa8, 0x14, 0x94, 0xf0, 0x5e, 0xbc, 0xcf, 0x10,
+  0xd4, 0x15, 0x94, 0xf0, 0x96, 0xbb, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x5e, 0x13, 0x94, 0xf0, 0xf0, 0xbb, 0xcf, 0x10,
+  0x8a, 0x14, 0x94, 0xf0, 0x28, 0xbb, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x50, 0x12, 0x94, 0xf0, 0x0a, 0xbb, 0xcf, 0x10,
+  0x7c, 0x13, 0x94, 0xf0, 0x42, 0xba, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xa6, 0x11, 0x94, 0xf0, 0xde, 0xb9, 0xcf, 0x10,
+  0xd2, 0x12, 0x94, 0xf0, 0x16, 0xb9, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x6a, 0x11, 0x94, 0xf0, 0x8a, 0xb8, 0xcf, 0x10,
+  0x96, 0x12, 0x94, 0xf0, 0xc2, 0xb7, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xa6, 0x11, 0x94, 0xf0, 0x36, 0xb7, 0xcf, 0x10,
+  0xd2, 0x12, 0x94, 0xf0, 0x6e, 0xb6, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x50, 0x12, 0x94, 0xf0, 0x0a, 0xb6, 0xcf, 0x10,
+  0x7c, 0x13, 0x94, 0xf0, 0x42, 0xb5, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x5e, 0x13, 0x94, 0xf0, 0x24, 0xb5, 0xcf, 0x10,
+  0x8a, 0x14, 0x94, 0xf0, 0x5c, 0xb4, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xa8, 0x14, 0x94, 0xf0, 0xb6, 0xb4, 0xcf, 0x10,
+  0xd4, 0x15, 0x94, 0xf0, 0xee, 0xb3, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xfc, 0x15, 0x94, 0xf0, 0xb6, 0xb4, 0xcf, 0x10,
+  0x28, 0x17, 0x94, 0xf0, 0xee, 0xb3, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x46, 0x17, 0x94, 0xf0, 0x24, 0xb5, 0xcf, 0x10,
+  0x72, 0x18, 0x94, 0xf0, 0x5c, 0xb4, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x54, 0x18, 0x94, 0xf0, 0x0a, 0xb6, 0xcf, 0x10,
+  0x80, 0x19, 0x94, 0xf0, 0x42, 0xb5, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0xfe, 0x18, 0x94, 0xf0, 0x36, 0xb7, 0xcf, 0x10,
+  0x2a, 0x1a, 0x94, 0xf0, 0x6e, 0xb6, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x3a, 0x19, 0x94, 0xf0, 0x8a, 0xb8, 0xcf, 0x10,
+  0x66, 0x1a, 0x94, 0xf0, 0xc2, 0xb7, 0xcf, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0x00,
+  0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10, 0x18, 0xd9, 0x91, 0xf0, 0xa0, 0x4a, 0xd2, 0x10,
+  0x2c, 0xcf, 0x91, 0xf0, 0xc0, 0x48, 0xd2, 0x10, 0x4e, 0x93, 0x92, 0xf0, 0x32, 0x86, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x05, 0x00,
+  0x52, 0x94, 0x92, 0xf0, 0x64, 0x27, 0xd2, 0x10, 0x06, 0x90, 0x92, 0xf0, 0x92, 0x26, 0xd2, 0x10,
+  0xa8, 0x98, 0x92, 0xf0, 0x40, 0x28, 0xd2, 0x10, 0xe6, 0xd3, 0x91, 0xf0, 0xba, 0x49, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x04, 0x00,
+  0xca, 0x62, 0x92, 0xf0, 0xf8, 0x2f, 0xd1, 0x10, 0x70, 0x62, 0x92, 0xf0, 0x98, 0x35, 0xd1, 0x10,
+  0x9c, 0x63, 0x92, 0xf0, 0x8a, 0x2a, 0xd1, 0x10, 0x52, 0x94, 0x92, 0xf0, 0x64, 0x27, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x03, 0x00,
+  0xe8, 0x0d, 0x92, 0xf0, 0x52, 0x53, 0xd1, 0x10, 0x2e, 0x13, 0x92, 0xf0, 0x20, 0x53, 0xd1, 0x10,
+  0xc0, 0x08, 0x92, 0xf0, 0x5c, 0x53, 0xd1, 0x10, 0xca, 0x62, 0x92, 0xf0, 0xf8, 0x2f, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00, 0x04, 0x00,
+  0x94, 0x61, 0x92, 0xf0, 0x1a, 0xcc, 0xd1, 0x10, 0xfc, 0x5d, 0x92, 0xf0, 0x1a, 0xc7, 0xd1, 0x10,
+  0xea, 0x65, 0x92, 0xf0, 0xa2, 0xd0, 0xd1, 0x10, 0xe8, 0x0d, 0x92, 0xf0, 0x52, 0x53, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x04, 0x00,
+  0x24, 0xf5, 0x91, 0xf0, 0xe4, 0xde, 0xd1, 0x10, 0x12, 0xf8, 0x91, 0xf0, 0x54, 0xdd, 0xd1, 0x10,
+  0xc2, 0xf2, 0x91, 0xf0, 0x66, 0xdf, 0xd1, 0x10, 0x94, 0x61, 0x92, 0xf0, 0x1a, 0xcc, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x03, 0x00,
+  0x0a, 0xf1, 0x91, 0xf0, 0xc2, 0x1e, 0xd2, 0x10, 0x9c, 0xf0, 0x91, 0xf0, 0xde, 0x1b, 0xd2, 0x10,
+  0x7c, 0xf2, 0x91, 0xf0, 0x3c, 0x22, 0xd2, 0x10, 0x24, 0xf5, 0x91, 0xf0, 0xe4, 0xde, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x00,
+  0x5e, 0x8e, 0x91, 0xf0, 0xa4, 0x50, 0xd2, 0x10, 0xe6, 0x92, 0x91, 0xf0, 0xda, 0x51, 0xd2, 0x10,
+  0x58, 0x8a, 0x91, 0xf0, 0x1a, 0x4e, 0xd2, 0x10, 0x0a, 0xf1, 0x91, 0xf0, 0xc2, 0x1e, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x00, 0x05, 0x00,
+  0x4a, 0x38, 0x92, 0xf0, 0xc4, 0x8a, 0xd2, 0x10, 0x58, 0x34, 0x92, 0xf0, 0x8e, 0x89, 0xd2, 0x10,
+  0xd8, 0x3b, 0x92, 0xf0, 0x96, 0x8b, 0xd2, 0x10, 0x5e, 0x8e, 0x91, 0xf0, 0xa4, 0x50, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x05, 0x00,
+  0x34, 0x4d, 0x93, 0xf0, 0x6e, 0x72, 0xd2, 0x10, 0xb6, 0x48, 0x93, 0xf0, 0x14, 0x72, 0xd2, 0x10,
+  0xd0, 0x51, 0x93, 0xf0, 0xfa, 0x72, 0xd2, 0x10, 0x4a, 0x38, 0x92, 0xf0, 0xc4, 0x8a, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x04, 0x00,
+  0x74, 0x3f, 0x93, 0xf0, 0x4e, 0xed, 0xd1, 0x10, 0x12, 0x42, 0x93, 0xf0, 0x26, 0xf2, 0xd1, 0x10,
+  0x6c, 0x3d, 0x93, 0xf0, 0x7a, 0xe9, 0xd1, 0x10, 0x34, 0x4d, 0x93, 0xf0, 0x6e, 0x72, 0xd2, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x04, 0x00,
+  0x16, 0x02, 0x93, 0xf0, 0xc8, 0x69, 0xd1, 0x10, 0x4e, 0x06, 0x93, 0xf0, 0x0c, 0x6c, 0xd1, 0x10,
+  0x42, 0xfe, 0x92, 0xf0, 0xf2, 0x67, 0xd1, 0x10, 0x74, 0x3f, 0x93, 0xf0, 0x4e, 0xed, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x03, 0x00,
+  0x78, 0x09, 0x93, 0xf0, 0x1e, 0x9b, 0xd1, 0x10, 0xba, 0x08, 0x93, 0xf0, 0x90, 0x97, 0xd1, 0x10,
+  0x9a, 0x0a, 0x93, 0xf0, 0xde, 0x9e, 0xd1, 0x10, 0x16, 0x02, 0x93, 0xf0, 0xc8, 0x69, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x04, 0x00,
+  0x8c, 0xa0, 0x92, 0xf0, 0x44, 0x1b, 0xd1, 0x10, 0xa2, 0xa3, 0x92, 0xf0, 0x0a, 0x1e, 0xd1, 0x10,
+  0x58, 0x9d, 0x92, 0xf0, 0x48, 0x17, 0xd1, 0x10, 0x78, 0x09, 0x93, 0xf0, 0x1e, 0x9b, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x04, 0x00,
+  0xac, 0xa8, 0x92, 0xf0, 0x0e, 0x83, 0xd1, 0x10, 0xee, 0xa7, 0x92, 0xf0, 0xfa, 0x7d, 0xd1, 0x10,
+  0xce, 0xa9, 0x92, 0xf0, 0x28, 0x87, 0xd1, 0x10, 0x8c, 0xa0, 0x92, 0xf0, 0x44, 0x1b, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00,
+  0x98, 0x8f, 0x92, 0xf0, 0x46, 0x5a, 0xd1, 0x10, 0xb4, 0x91, 0x92, 0xf0, 0x06, 0x5e, 0xd1, 0x10,
+  0xb4, 0x8c, 0x92, 0xf0, 0x96, 0x55, 0xd1, 0x10, 0xac, 0xa8, 0x92, 0xf0, 0x0e, 0x83, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x05, 0x00,
+  0x58, 0x8e, 0x92, 0xf0, 0xd0, 0xf7, 0xd1, 0x10, 0x62, 0x8e, 0x92, 0xf0, 0x24, 0xf4, 0xd1, 0x10,
+  0x62, 0x8e, 0x92, 0xf0, 0xcc, 0xfb, 0xd1, 0x10, 0x98, 0x8f, 0x92, 0xf0, 0x46, 0x5a, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x00, 0x04, 0x00,
+  0x4e, 0x93, 0x92, 0xf0, 0x32, 0x86, 0xd2, 0x10, 0xc0, 0x94, 0x92, 0xf0, 0x06, 0x80, 0xd2, 0x10,
+  0x5e, 0x92, 0x92, 0xf0, 0x54, 0x8c, 0xd2, 0x10, 0x58, 0x8e, 0x92, 0xf0, 0xd0, 0xf7, 0xd1, 0x10,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49, 0x72, 0x65, 0x6e,
+  0x65, 0x00, 0x43, 0x65, 0x6e, 0x74, 0x75, 0x72, 0x69, 0x6f, 0x6e, 0x00,
+};
+
+}  // namespace coursedb
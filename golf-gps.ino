@@ -1,7 +1,7 @@
 // golf-gps.ino
 #include <Arduino.h>
 #include <Wire.h>
-#include <Ticker.h>                 // for lv_tick, GPS & IMU ticks
+#include <Ticker.h>                 // for lv_tick & IMU ticks
 #include <Arduino_GFX_Library.h>
 #include <Arduino_DriveBus_Library.h>
 
@@ -14,17 +14,17 @@
 #include "GpsManager.h"
 #include "CoursesManager.h"
 #include "IMUManager.h"
+#include "NmeaCapture.h"
+#include "Geofence.h"
 
 // ─── CONFIG ────────────────────────────────────────────────────────────────
 static constexpr uint32_t LV_TICK_PERIOD_MS = 1;    // LVGL 1 ms tick
 static constexpr uint16_t DRAW_BUF_HEIGHT    = 80; // LVGL buffer lines
 
-static constexpr uint32_t GPS_TICK_MS = 200;  // GPS @ ~5 Hz
 static constexpr uint32_t IMU_TICK_MS =   5;  // IMU @ ~200 Hz
 
 // ─── HARDWARE OBJECTS ──────────────────────────────────────────────────────
 static Ticker lvglTicker;
-static Ticker gpsTicker;
 static Ticker imuTicker;
 
 static Arduino_DataBus *bus   = nullptr;
@@ -42,7 +42,6 @@ static void dispFlush(lv_disp_drv_t*, const lv_area_t*, lv_color_t*);
 static void touchISR();
 static void touchRead(lv_indev_drv_t*, lv_indev_data_t*);
 static void onImuTick();
-static void onGpsTick();
 
 static void initSerial();
 static void initLVGL();
@@ -151,15 +150,12 @@ static void initTouch() {
   }
 }
 
-// Initialize GPS + ticker
+// Initialize GPS at its power-on baud; begin() negotiates the link up and
+// ingestion is then driven by UART receive events
 static void initGPS() {
   GpsManager::instance().begin(
     &Serial1, 9600,
-    GPS_RX, GPS_TX,
-    PMTK_SET_NMEA_OUTPUT_ALLDATA,
-    PMTK_SET_NMEA_UPDATE_5HZ);
-
-  gpsTicker.attach_ms(GPS_TICK_MS, onGpsTick);
+    GPS_RX, GPS_TX);
 }
 
 // Initialize IMU + ticker
@@ -183,11 +179,6 @@ static void onImuTick() {
   IMUManager::instance().update();
 }
 
-// GPS tick: read fix, run EKF update
-static void onGpsTick() {
-  GpsManager::instance().update();
-}
-
 
 // ─── ARDUINO HOOKS ─────────────────────────────────────────────────────────
 void setup() {
@@ -197,22 +188,44 @@ void setup() {
   initLVGL();
   initGPS();
   initIMU();
+  NmeaCapture::instance().begin();   // raw NMEA to SD when a card is in
 
   CoursesManager::instance().beginFromFlash();
+
+  // fence crossings to the console
+  GeofenceEngine::instance().subscribe([](const FenceEvent& e) {
+    static const char* const KIND[] = { "boundary", "tee", "green", "hazard" };
+    Serial.printf("%s %s %u (hole %u)\n", e.entered ? "Enter" : "Exit",
+                  KIND[uint8_t(e.kind)], unsigned(e.ref), unsigned(e.hole + 1));
+  });
+
   PageManager::instance().pushPage(new HomePage());
 }
 
 void loop() {
   lv_timer_handler();  // pump LVGL
 
+  // 's' on the console: binary GPS link-health frame, then the open
+  // page's counters as a text line
+  if (Serial.available() && Serial.read() == 's') {
+    GpsManager::instance().dumpStats(Serial);
+    if (Page* page = PageManager::instance().current()) page->printStats(Serial);
+  }
+
   // ** Serial out moved here **
-  if (GpsManager::instance().hasNewData()) {
-    auto d = GpsManager::instance().fetchData();
+  // Page timers inside lv_timer_handler() fetch too, which clears
+  // hasNewData(); follow the epoch number so no fix skips the fences.
+  static uint32_t lastSeq = 0;
+  auto d = GpsManager::instance().fetchData();
+  if (d.seq != lastSeq) {
+    lastSeq = d.seq;
     if (!d.fix) {
       Serial.println("No fix");
     } else {
-      Serial.printf("Fix: %.6f, %.6f  sats:%u  HDOP:%.1f\n",
-                    d.lat, d.lon, d.sats, d.hdop);
+      Serial.printf("Fix: %.7f, %.7f  sats:%u  HDOP:%.1f\n",
+                    geo::toDegrees(d.pos.lat), geo::toDegrees(d.pos.lon),
+                    d.sats, d.hdop);
+      GeofenceEngine::instance().update(d.pos);   // events on this task
     }
   }
 
@@ -0,0 +1,269 @@
+// arena_bench.cpp — heap use and per-hole iteration of the arena-decoded
+// course layout next to the vector-per-hole layout it replaced.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o arena_bench arena_bench.cpp ../CourseImage.cpp ../CourseIndex.cpp ../Geo.cpp
+//
+//   arena_bench [courses] [holes] [hazards per hole]
+//
+// Builds a synthetic course image (default 500 courses of 18 holes, one
+// hazard each), then holds every course both ways at once:
+//
+//   before  Course { String name; vector<Hole> }, Hole { vector<Hazard>,
+//           vector<Geo> layups, green }, Hazard { String type }, as
+//           parseCourses() built them (std::string stands in for String)
+//   arena   CourseImage::decode() into one Arena per course
+//
+// and counts what each asked of the heap, through a counting operator
+// new.  std::string keeps short hazard types in place where String went to
+// the heap for each, so the "before" figures are a floor.  Iteration is the
+// hole page's walk: every hazard's distance from its pin plus a test of its
+// type.  Exits non-zero if the two layouts disagree over that walk.
+#include "CourseImage.h"
+#include "host_check.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// —— Heap accounting ——
+
+static size_t g_bytes = 0, g_allocs = 0;
+static bool   g_count = false;
+
+void* operator new(size_t n) {
+  if (g_count) {
+    g_bytes += n;
+    ++g_allocs;
+  }
+  if (void* p = malloc(n ? n : 1)) return p;
+  throw std::bad_alloc();
+}
+void* operator new[](size_t n) { return operator new(n); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// —— The layout before the arena ——
+
+struct OldHazard {
+  std::string type;
+  Geo   loc;
+  float radius;
+};
+
+struct OldHole {
+  int  number, par;
+  Geo  pin, front, back, tee;
+  bool hasTee;
+  std::vector<OldHazard> hazards;
+  std::vector<Geo>       layups, green;
+};
+
+struct OldCourse {
+  std::string          name;
+  Geo                  location;
+  std::vector<OldHole> holes;
+  std::vector<Geo>     boundary;
+  geo::LocalFrame      frame;
+};
+
+// What parseCourses() built from the JSON, made here from a decoded course.
+static OldCourse legacy(const Course& c) {
+  OldCourse o{ c.name, c.location, {}, { c.boundary.begin(), c.boundary.end() },
+               c.frame };
+  for (const Hole& h : c.holes) {
+    OldHole oh{ h.number, h.par, h.pin, h.front, h.back, h.tee, h.hasTee, {},
+                { h.layups.begin(), h.layups.end() },
+                { h.green.begin(), h.green.end() } };
+    for (const Hazard& z : h.hazards)
+      oh.hazards.push_back(OldHazard{ hazardName(z.type), z.loc, z.radius });
+    o.holes.push_back(std::move(oh));
+  }
+  return o;
+}
+
+// —— A synthetic image ——
+
+template <typename T>
+static void put(std::vector<uint8_t>& out, const T& rec) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&rec);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+static void putAt(std::vector<uint8_t>& out, size_t at, const T& rec) {
+  memcpy(&out[at], &rec, sizeof(T));
+}
+
+// Courses scattered over a region, holes strung 400 m apart, hazards
+// between tee and pin.  Laid out as tools/course_compiler writes images.
+static std::vector<uint8_t> image(size_t courses, size_t holes, size_t hazards) {
+  using namespace courseimg;
+  Rng rng(73);
+  std::vector<Geo> locs;
+  for (size_t i = 0; i < courses; ++i)
+    locs.push_back(geo::fromDegrees(rng.uniform(-34, -22), rng.uniform(18, 32)));
+
+  std::vector<uint8_t> out;
+  Header h{ MAGIC, VERSION, 0, uint32_t(courses), sizeof(Header), 0, 0,
+            uint16_t(holes), uint16_t(holes * hazards) };
+  put(out, h);
+  out.resize(out.size() + courses * sizeof(Entry));
+  h.tree = uint32_t(out.size());
+  CourseIndex tree;
+  tree.build(locs.data(), locs.size());
+  const uint8_t* t = static_cast<const uint8_t*>(tree.data());
+  out.insert(out.end(), t, t + tree.bytes());
+
+  std::vector<Entry> entries(courses);
+  for (size_t i = 0; i < courses; ++i) {
+    geo::LocalFrame f(locs[i], COURSE_EARTH);
+    Entry& e = entries[i];
+    e = Entry{};
+    e.location = e.origin = locs[i];
+    e.block   = uint32_t(out.size());
+    e.holes   = uint16_t(holes);
+    e.hazards = uint16_t(holes * hazards);
+    e.earth   = uint8_t(f.earth());
+    e.mPerE7Lat = f.mPerE7Lat();
+    e.mPerE7Lon = f.mPerE7Lon();
+    e.xSlope  = f.xSlope();
+    e.ySlope  = f.ySlope();
+
+    std::vector<HazardRecord> zs;
+    for (size_t k = 0; k < holes; ++k) {
+      geo::Vec2 tee{ float(k % 6) * 400.0f, float(k / 6) * 400.0f };
+      geo::Vec2 pin{ tee.x + float(rng.uniform(-80, 80)), tee.y + float(rng.uniform(120, 480)) };
+      HoleRecord hr{};
+      hr.number = uint16_t(k + 1);
+      hr.par    = uint8_t(3 + k % 3);
+      hr.hasTee = 1;
+      hr.tee    = f.toGeo(tee);
+      hr.pin    = f.toGeo(pin);
+      hr.front  = f.toGeo(geo::Vec2{ pin.x, pin.y - 12 });
+      hr.back   = f.toGeo(geo::Vec2{ pin.x, pin.y + 12 });
+      hr.hazards  = uint16_t(zs.size());
+      hr.nHazards = uint16_t(hazards);
+      for (size_t z = 0; z < hazards; ++z) {
+        HazardRecord zr{};
+        double a = rng.uniform(0.3, 0.9);
+        zr.loc    = f.toGeo(geo::Vec2{ float(tee.x + a * (pin.x - tee.x) + rng.uniform(-25, 25)),
+                                       float(tee.y + a * (pin.y - tee.y)) });
+        zr.radius = float(rng.uniform(5, 20));
+        zr.type   = uint8_t(1 + rng.next() % 4);
+        zs.push_back(zr);
+      }
+      put(out, hr);
+    }
+    for (const HazardRecord& zr : zs) put(out, zr);
+  }
+
+  // names last, as the string table
+  for (size_t i = 0; i < courses; ++i) {
+    entries[i].name = uint32_t(out.size());
+    std::string name = "Course " + std::to_string(i);
+    out.insert(out.end(), name.c_str(), name.c_str() + name.size() + 1);
+  }
+  while (out.size() % 4) out.push_back(0);
+  h.size = uint32_t(out.size());
+  putAt(out, 0, h);
+  for (size_t i = 0; i < courses; ++i)
+    putAt(out, sizeof(Header) + i * sizeof(Entry), entries[i]);
+  return out;
+}
+
+// —— Runs ——
+
+int main(int argc, char** argv) {
+  size_t nCourses = argc > 1 ? size_t(atoi(argv[1])) : 500;
+  size_t nHoles   = argc > 2 ? size_t(atoi(argv[2])) : 18;
+  size_t nHazards = argc > 3 ? size_t(atoi(argv[3])) : 1;
+
+  std::vector<uint8_t> bytes = image(nCourses, nHoles, nHazards);
+  CourseImage img;
+  CHECK(img.open(bytes.data(), bytes.size()));
+  CHECK(img.size() == nCourses);
+  if (img.size() != nCourses) return checkSummary(argv[0]);
+
+  // every course held both ways, counting only what the holding costs
+  std::vector<OldCourse> before;
+  std::vector<Arena>     arenas(nCourses);
+  std::vector<Course>    after(nCourses);
+  before.reserve(nCourses);
+  size_t beforeBytes = 0, beforeAllocs = 0, arenaBytes = 0, arenaAllocs = 0;
+  for (size_t i = 0; i < nCourses; ++i) {
+    g_count = true;
+    arenas[i].reserve(img.arenaBytes());
+    CHECK(img.decode(i, after[i], arenas[i]));
+    g_count = false;
+    arenaBytes += g_bytes;
+    arenaAllocs += g_allocs;
+    g_bytes = g_allocs = 0;
+
+    Arena scratch;
+    scratch.reserve(img.arenaBytes());
+    Course c;
+    img.decode(i, c, scratch);
+    g_count = true;
+    before.push_back(legacy(c));
+    g_count = false;
+    beforeBytes += g_bytes;
+    beforeAllocs += g_allocs;
+    g_bytes = g_allocs = 0;
+  }
+
+  // the hole page's walk over every hole of every course
+  size_t holes = nCourses * nHoles;
+  float  sumBefore = 0, sumAfter = 0;
+  size_t bunkersBefore = 0, bunkersAfter = 0;
+  double nsBefore = nsPer(50, [&](size_t) {
+    for (const OldCourse& c : before)
+      for (const OldHole& h : c.holes)
+        for (const OldHazard& z : h.hazards) {
+          sumBefore += c.frame.distance(h.pin, z.loc);
+          bunkersBefore += z.type == "bunker";
+        }
+  }) / double(holes);
+  double nsAfter = nsPer(50, [&](size_t) {
+    for (const Course& c : after)
+      for (const Hole& h : c.holes)
+        for (const Hazard& z : h.hazards) {
+          sumAfter += c.frame.distance(h.pin, z.loc);
+          bunkersAfter += z.type == HazardType::Bunker;
+        }
+  }) / double(holes);
+  keep(sumBefore + sumAfter);
+  CHECK(sumBefore == sumAfter);
+  CHECK(bunkersBefore == bunkersAfter);
+
+  // switching courses: decode into the one arena, or rebuild the vectors
+  Arena arena;
+  arena.reserve(img.arenaBytes());
+  Course c;
+  double decodeNs = nsPer(200'000, [&](size_t i) {
+    img.decode(i % nCourses, c, arena);
+    keep(c.holes.size());
+  });
+  double rebuildNs = nsPer(20'000, [&](size_t i) {
+    img.decode(i % nCourses, c, arena);
+    OldCourse o = legacy(c);
+    keep(o.holes.size());
+  });
+
+  printf("%zu courses, %zu holes and %zu hazards each (image %zu B):\n"
+         "  before: %6.0f B/course in %4.1f allocations, %5.1f ns per hole iterated, "
+         "%.2f us to switch course\n"
+         "  arena:  %6.0f B/course in %4.1f allocations, %5.1f ns per hole iterated, "
+         "%.2f us to switch course\n",
+         nCourses, nHoles, nHoles * nHazards, bytes.size(),
+         double(beforeBytes) / nCourses, double(beforeAllocs) / nCourses, nsBefore,
+         rebuildNs / 1e3,
+         double(arenaBytes) / nCourses, double(arenaAllocs) / nCourses, nsAfter,
+         decodeNs / 1e3);
+  CHECK(arenaAllocs == nCourses);
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,182 @@
+// byte_ring_test.cpp — ByteRing through wrap-around and overflow, then fed
+// by a simulated UART: a producer thread pushes receiver output in
+// bulk-read-sized chunks while a consumer thread tokenizes it in place the
+// way GpsManager::update() does.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -pthread -I.. -o byte_ring_test byte_ring_test.cpp ../NmeaParser.cpp ../EpochAssembler.cpp
+//
+// Exits non-zero if any check fails.
+#include "ByteRing.h"
+#include "EpochAssembler.h"
+#include "NmeaBudget.h"
+#include "NmeaParser.h"
+#include "host_check.h"
+#include "nmea_synth.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Drain everything through peek()/consume() into `out`.
+template <size_t N>
+static void drain(ByteRing<N>& ring, std::vector<uint8_t>& out) {
+  const uint8_t* p;
+  size_t n;
+  while ((n = ring.peek(p)) > 0) {
+    out.insert(out.end(), p, p + n);
+    ring.consume(n);
+  }
+}
+
+static void wrapAround() {
+  ByteRing<64> ring;
+  std::vector<uint8_t> sent, got;
+  uint8_t next = 0;
+  Rng rng(3);
+  // odd-sized writes and partial reads walk the indices round the ring
+  // many times over; nothing is lost while there is room
+  for (int i = 0; i < 10'000; ++i) {
+    uint8_t chunk[40];
+    size_t n = 1 + rng.next() % sizeof(chunk);
+    if (n > ring.capacity() - ring.size()) n = ring.capacity() - ring.size();
+    for (size_t k = 0; k < n; ++k) chunk[k] = next++;
+    CHECK(ring.write(chunk, n) == n);
+    sent.insert(sent.end(), chunk, chunk + n);
+
+    const uint8_t* p;
+    size_t run = ring.peek(p);
+    size_t take = run ? rng.next() % (run + 1) : 0;
+    got.insert(got.end(), p, p + take);
+    ring.consume(take);
+  }
+  drain(ring, got);
+  CHECK(got == sent);
+  CHECK(ring.overruns() == 0);
+  CHECK(ring.size() == 0);
+  CHECK(ring.highWater() <= ring.capacity());
+
+  // a contiguous run stops at the end of the buffer; the rest follows
+  ByteRing<16> small;
+  uint8_t a[12] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+  small.write(a, 12);
+  const uint8_t* p;
+  small.consume(small.peek(p));
+  small.write(a, 10);                        // 4 at the end, 6 at the start
+  CHECK(small.peek(p) == 4 && p[0] == 1);
+  small.consume(4);
+  CHECK(small.peek(p) == 6 && p[0] == 5);
+}
+
+static void overflow() {
+  ByteRing<32> ring;
+  uint8_t buf[100];
+  for (size_t i = 0; i < sizeof(buf); ++i) buf[i] = uint8_t(i);
+
+  CHECK(ring.write(buf, 20) == 20);
+  CHECK(ring.write(buf + 20, 20) == 12);     // 8 dropped, newest first
+  CHECK(ring.overruns() == 8);
+  CHECK(ring.highWater() == 32);
+  CHECK(ring.write(buf, 5) == 0);            // full: all dropped
+  CHECK(ring.overruns() == 13);
+
+  // what is kept is the oldest data, intact and in order
+  std::vector<uint8_t> got;
+  drain(ring, got);
+  CHECK(got.size() == 32);
+  for (size_t i = 0; i < got.size(); ++i) CHECK(got[i] == i);
+
+  // room again after a drain; counters only ever grow
+  CHECK(ring.write(buf, 32) == 32);
+  CHECK(ring.overruns() == 13);
+  CHECK(ring.highWater() == 32);
+}
+
+// The ring GpsManager sizes for its link (four epochs of the parsed mix),
+// fed at 10 Hz by a producer thread.  The consumer goes quiet for `stallMs`
+// once in a while, as the parser task would behind a busier one.
+static void simulatedUart(uint32_t stallMs, bool expectDrops) {
+  static constexpr size_t N = nmea::ringCapacity(nmea::MIX_PARSED, 4);
+  ByteRing<N> ring;
+
+  std::vector<std::string> epochs;
+  GpsData d;
+  d.fix = true;
+  d.fixQuality = 1;
+  d.sats = 8;
+  d.pos = geo::fromDegrees(-25.9, 28.2);
+  for (int i = 0; i < 200; ++i, synth::tick(d, 100)) {
+    d.pos.lat += 90;
+    epochs.push_back(synth::epoch(d));
+  }
+
+  std::atomic<bool> done{ false };
+  size_t sent = 0;
+  std::thread producer([&] {
+    Rng rng(7);
+    for (const std::string& e : epochs) {
+      // the UART task hands over whatever the driver holds, ≤128 bytes
+      for (size_t at = 0; at < e.size();) {
+        size_t n = std::min<size_t>(e.size() - at, 1 + rng.next() % 128);
+        ring.write(reinterpret_cast<const uint8_t*>(e.data() + at), n);
+        at += n;
+      }
+      sent += e.size();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));  // 10x speed
+    }
+    done = true;
+  });
+
+  NmeaParser parser;
+  EpochAssembler epoch;
+  size_t fixes = 0, seen = 0;
+  auto stallEvery = std::chrono::milliseconds(500);
+  auto nextStall = std::chrono::steady_clock::now() + stallEvery;
+  for (;;) {
+    bool finished = done.load();
+    const uint8_t* p;
+    size_t n;
+    while ((n = ring.peek(p)) > 0) {
+      for (size_t i = 0; i < n; ++i)
+        if (epoch.add(parser, parser.feed(char(p[i])))) ++fixes;
+      seen += n;
+      ring.consume(n);
+    }
+    if (finished) break;
+    if (stallMs && std::chrono::steady_clock::now() > nextStall) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(stallMs));
+      nextStall = std::chrono::steady_clock::now() + stallEvery;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  producer.join();
+
+  printf("ring %zu B, consumer stalls %3u ms (%2u epochs): %zu of %zu bytes, "
+         "%u dropped, high water %zu, %zu fixes, %u truncated\n",
+         N, stallMs, stallMs / 10, seen, sent, ring.overruns(),
+         ring.highWater(), fixes, parser.truncated());
+
+  // every byte is either delivered or counted as dropped
+  CHECK(seen + ring.overruns() == sent);
+  if (expectDrops) {
+    CHECK(ring.overruns() > 0);
+    CHECK(ring.highWater() == N);
+    CHECK(fixes < epochs.size());
+  } else {
+    CHECK(ring.overruns() == 0);
+    CHECK(fixes == epochs.size());
+    CHECK(parser.truncated() == 0);
+  }
+}
+
+int main(int, char** argv) {
+  wrapAround();
+  overflow();
+  simulatedUart(0, false);
+  simulatedUart(30, false);     // three epochs behind: within four
+  simulatedUart(80, true);      // eight behind: the ring overflows
+  return checkSummary(argv[0]);
+}
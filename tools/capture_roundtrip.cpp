@@ -0,0 +1,150 @@
+// capture_roundtrip.cpp — write a capture the way NmeaCapture lays it out,
+// replay it through tools/nmea_replay, and check the epochs it prints are
+// the ones that went in.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o nmea_replay nmea_replay.cpp ../NmeaParser.cpp ../EpochAssembler.cpp ../Geo.cpp
+//   g++ -std=c++17 -O2 -I.. -o capture_roundtrip capture_roundtrip.cpp
+//
+//   capture_roundtrip [--minutes M] [--replay ./nmea_replay] [--keep out.cap]
+//
+// The round is M minutes (default 10) at 10 Hz, in UART-sized records
+// whose micros() stamps wrap partway through.  A second pass drops every
+// 50th record, as NmeaCapture does when the card falls behind, and checks
+// replay loses only the epochs those bytes carried.  `--minutes 300` is
+// the 5-hour soak: nmea_replay reports its throughput on stderr.  Exits
+// non-zero if any check fails.
+#include "host_check.h"
+#include "nmea_synth.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+struct Epoch {
+  uint32_t seq;
+  unsigned h, m, s, ms;
+  double   lat, lon;
+  int      fix;
+  unsigned quality, sats;
+  double   hdop, speed;
+  unsigned parts;
+};
+
+// What nmea_replay printed, one Epoch per CSV line.
+static std::vector<Epoch> replay(const char* tool, const char* path) {
+  std::vector<Epoch> out;
+  std::string cmd = std::string(tool) + " " + path;
+  FILE* p = popen(cmd.c_str(), "r");
+  if (!p) return out;
+  char line[256];
+  while (fgets(line, sizeof(line), p)) {
+    Epoch e;
+    if (sscanf(line, "%" SCNu32 ",%u:%u:%u.%u,%lf,%lf,%d,%u,%u,%lf,%lf,%u",
+               &e.seq, &e.h, &e.m, &e.s, &e.ms, &e.lat, &e.lon, &e.fix,
+               &e.quality, &e.sats, &e.hdop, &e.speed, &e.parts) == 13)
+      out.push_back(e);
+  }
+  CHECK(pclose(p) == 0);
+  return out;
+}
+
+int main(int argc, char** argv) {
+  double minutes = 10;
+  const char* tool = "./nmea_replay";
+  const char* keepPath = nullptr;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if      (!strcmp(argv[i], "--minutes")) minutes = atof(argv[i + 1]);
+    else if (!strcmp(argv[i], "--replay"))  tool = argv[i + 1];
+    else if (!strcmp(argv[i], "--keep"))    keepPath = argv[i + 1];
+  }
+
+  // the round, as the receiver reported it
+  std::vector<GpsData> truth;
+  std::vector<std::string> text;
+  Rng rng(5);
+  GpsData d;
+  d.fix = true;
+  d.fixQuality = 1;
+  d.day = 17;
+  d.month = 10;
+  d.year = 2026;
+  d.hour = 6;
+  d.pos = geo::fromDegrees(-25.9004, 28.2019);
+  size_t n = size_t(minutes * 600);
+  for (size_t i = 0; i < n; ++i, synth::tick(d, 100)) {
+    d.pos.lat += int32_t(rng.normal(10));
+    d.pos.lon += int32_t(rng.normal(10));
+    d.sats = uint8_t(6 + rng.next() % 8);
+    d.hdop = float(int(80 + rng.next() % 120)) / 100;
+    d.speedKnots = float(int(rng.next() % 400)) / 100;
+    d.seq = uint32_t(i + 1);
+    d.parts = GPS_PART_ALL;
+    truth.push_back(d);
+    text.push_back(synth::epoch(d));
+  }
+
+  // one burst per epoch, 100 ms apart; micros() wraps a minute in
+  uint32_t us0 = 0xFFFFFFFFu - 60'000'000u;
+  synth::CaptureWriter all;
+  for (size_t i = 0; i < n; ++i) all.add(uint32_t(us0 + i * 100'000), text[i]);
+
+  const char* path = keepPath ? keepPath : "/tmp/capture_roundtrip.cap";
+  CHECK(all.save(path));
+  std::vector<Epoch> got = replay(tool, path);
+  printf("%zu epochs captured (%zu bytes), %zu replayed\n", n,
+         all.bytes().size(), got.size());
+
+  CHECK(got.size() == n);
+  size_t bad = 0;
+  for (size_t i = 0; i < got.size() && i < n; ++i) {
+    const Epoch& e = got[i];
+    const GpsData& t = truth[i];
+    // four minute digits: within 1e-4 / 60 degree, half a last digit
+    bool ok = e.seq == t.seq && e.h == t.hour && e.m == t.minute &&
+              e.s == t.second && e.ms == t.millis &&
+              fabs(e.lat - geo::toDegrees(t.pos.lat)) <= 0.84e-6 &&
+              fabs(e.lon - geo::toDegrees(t.pos.lon)) <= 0.84e-6 &&
+              e.fix == 1 && e.quality == t.fixQuality && e.sats == t.sats &&
+              fabs(e.hdop - t.hdop) < 0.051 && fabs(e.speed - t.speedKnots) < 0.006 &&
+              e.parts == GPS_PART_ALL;
+    if (!ok && bad++ < 5)
+      fprintf(stderr, "epoch %zu: replayed %u %02u:%02u:%02u.%03u %.7f %.7f\n",
+              i + 1, e.seq, e.h, e.m, e.s, e.ms, e.lat, e.lon);
+  }
+  CHECK(bad == 0);
+
+  // drop every 50th record, as NmeaCapture does when the writer is behind:
+  // the sentences a gap cuts are lost, the epochs around them are not
+  std::vector<uint8_t> lossy(capture::MAGIC, capture::MAGIC + sizeof(capture::MAGIC));
+  size_t records = 0, dropped = 0;
+  synth::forEachRecord(all.bytes(), [&](uint32_t us, const uint8_t* p, size_t len) {
+    if (++records % 50 == 0) {
+      ++dropped;
+      return;
+    }
+    uint8_t h[capture::HEADER_LEN];
+    capture::putHeader(h, us, uint16_t(len));
+    lossy.insert(lossy.end(), h, h + sizeof(h));
+    lossy.insert(lossy.end(), p, p + len);
+  });
+  {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(lossy.data()), lossy.size());
+  }
+  std::vector<Epoch> some = replay(tool, path);
+  size_t whole = 0;
+  for (const Epoch& e : some) whole += e.parts == GPS_PART_ALL;
+  printf("%zu of %zu records dropped: %zu epochs replayed, %zu whole\n",
+         dropped, records, some.size(), whole);
+  CHECK(dropped > 0);
+  CHECK(whole >= n - 2 * dropped);     // a record touches at most two epochs
+  CHECK(some.size() <= n);
+
+  if (!keepPath) remove(path);
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,743 @@
+// course_compiler.cpp — turn the course JSON into a course image
+// (CourseImage.h): courses.bin for the "courses" flash partition, and
+// courses_db.h, the same image built into the firmware as a fallback.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o course_compiler course_compiler.cpp
+//       ../Geo.cpp ../CourseIndex.cpp ../HoleIndex.cpp ../CourseImage.cpp
+//       ../JsonReader.cpp ../CourseJson.cpp
+//
+//   course_compiler [--strict] [--report] [--bench] [-o ../courses_db.h]
+//       [--image courses.bin] ../courses_data.h
+//   esptool.py write_flash 0xc90000 courses.bin    # "courses" in partitions.csv
+//
+// Input is either plain JSON or a header holding it in an R"RAWJSON(...)"
+// literal.  It is mapped and streamed through CourseJsonReader a few KB at
+// a time, each course compiled as it closes, so no document tree is ever
+// built however large the library.  Everything the firmware used to work
+// out at boot is done here: default par, tee fallback, the course frame,
+// interned strings, name order and the nearest-course tree.
+//
+// The geometry is checked on the way through.  Errors (coordinates off the
+// globe or missing, with their byte offset; negative radii) stop the build;
+// warnings (a pin shared with another hole, a green nowhere near its pin,
+// ...) are printed, and stop it too under --strict.  --report prints each
+// course's flash and RAM footprint on the ESP32; --bench times reading the
+// image the way the firmware does, mapped from --image when given.
+// Diagnostics, the report and the timings go to stderr, the header to
+// stdout or -o.
+#include "CourseImage.h"
+#include "CourseIndex.h"
+#include "CourseJson.h"
+#include "CourseTypes.h"
+#include "GreenOutline.h"
+#include "HoleIndex.h"
+#include "JsonReader.h"
+#include "TargetTable.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// —— Flattened tables ——
+
+struct HazardRec {
+  HazardType  type;
+  Geo         loc;
+  float       radius;
+  std::string label;    // as given, for diagnostics
+};
+
+struct HoleRec {
+  int number, par;
+  Geo pin, front, back, tee;
+  bool hasTee;
+  uint32_t hazards, nHazards, layups, nLayups, green, nGreen;
+};
+
+struct CourseRec {
+  uint32_t name;
+  Geo location;
+  uint32_t holes, nHoles, boundary, nBoundary;
+  geo::LocalFrame frame;
+};
+
+struct Db {
+  std::string            strings;
+  std::map<std::string, uint32_t> interned;
+  std::vector<Geo>       points;
+  std::vector<HazardRec> hazards;
+  std::vector<HoleRec>   holes;
+  std::vector<CourseRec> courses;
+
+  uint32_t intern(const std::string& s) {
+    auto it = interned.find(s);
+    if (it != interned.end()) return it->second;
+    uint32_t at = uint32_t(strings.size());
+    strings += s;
+    strings += '\0';
+    interned.emplace(s, at);
+    return at;
+  }
+};
+
+// Free-text "type" onto HazardType; anything unrecognised is Other
+static HazardType hazardType(std::string s) {
+  for (char& ch : s) ch = char(tolower((unsigned char)ch));
+  if (s == "ob" || s == "oob" || s == "out of bounds")
+    return HazardType::OutOfBounds;
+  static const std::pair<const char*, HazardType> WORDS[] = {
+    { "bunker", HazardType::Bunker }, { "sand",  HazardType::Bunker },
+    { "water",  HazardType::Water },  { "pond",  HazardType::Water },
+    { "lake",   HazardType::Water },  { "creek", HazardType::Water },
+    { "river",  HazardType::Water },  { "tree",  HazardType::Trees },
+    { "wood",   HazardType::Trees },
+  };
+  for (const auto& w : WORDS)
+    if (s.find(w.first) != std::string::npos) return w.second;
+  return HazardType::Other;
+}
+
+static uint32_t addPoints(Db& db, const std::vector<Geo>& pts, uint32_t& n) {
+  uint32_t first = uint32_t(db.points.size());
+  db.points.insert(db.points.end(), pts.begin(), pts.end());
+  n = uint32_t(pts.size());
+  return first;
+}
+
+// Centre the course's local frame on its greens
+static geo::LocalFrame makeFrame(const CourseRec& c, const Db& db) {
+  if (!c.nHoles) return geo::LocalFrame(c.location, COURSE_EARTH);
+  int64_t lat = 0, lon = 0;
+  for (uint32_t i = 0; i < c.nHoles; ++i) {
+    const HoleRec& h = db.holes[c.holes + i];
+    lat += h.pin.lat;
+    lon += geo::deltaLon(c.location.lon, h.pin.lon);
+  }
+  int64_t n = int64_t(c.nHoles);
+  return geo::LocalFrame(Geo{ int32_t(lat / n),
+                              int32_t(c.location.lon + lon / n) },
+                         COURSE_EARTH);
+}
+
+static void compile(const JsonCourse& jc, Db& db) {
+  CourseRec c{};
+  c.name     = db.intern(jc.name);
+  c.location = jc.location;
+  c.holes    = uint32_t(db.holes.size());
+
+  for (const JsonHole& jh : jc.holes) {
+    HoleRec h{};
+    h.number = jh.number;
+    h.par    = jh.par;
+    h.pin    = jh.pin;
+    h.front  = jh.front;
+    h.back   = jh.back;
+    h.hasTee = jh.hasTee;
+    h.tee    = jh.tee;
+
+    h.hazards = uint32_t(db.hazards.size());
+    for (const JsonHazard& jz : jh.hazards)
+      db.hazards.push_back(HazardRec{ hazardType(jz.type), jz.loc, jz.radius,
+                                      jz.type });
+    h.nHazards = uint32_t(db.hazards.size()) - h.hazards;
+    h.layups = addPoints(db, jh.layups, h.nLayups);
+    h.green  = addPoints(db, jh.green, h.nGreen);
+    db.holes.push_back(h);
+  }
+  c.nHoles = uint32_t(db.holes.size()) - c.holes;
+
+  // a round is a loop: hole 1 tees off near the last green
+  for (uint32_t i = 0; i < c.nHoles; ++i) {
+    HoleRec& h = db.holes[c.holes + i];
+    if (!h.hasTee) h.tee = db.holes[c.holes + (i ? i - 1 : c.nHoles - 1)].pin;
+  }
+
+  c.boundary = addPoints(db, jc.boundary, c.nBoundary);
+  c.frame    = makeFrame(c, db);
+  db.courses.push_back(c);
+}
+
+// The image lists courses by name, so the course list needs no sort
+static void sortByName(Db& db) {
+  std::stable_sort(db.courses.begin(), db.courses.end(),
+                   [&db](const CourseRec& a, const CourseRec& b) {
+                     return strcmp(&db.strings[a.name], &db.strings[b.name]) < 0;
+                   });
+}
+
+// —— Validation ——
+
+struct Diag {
+  int errors = 0, warnings = 0;
+
+  void error(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    report("error", fmt, ap);
+    va_end(ap);
+    ++errors;
+  }
+  void warn(const char* fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    report("warning", fmt, ap);
+    va_end(ap);
+    ++warnings;
+  }
+
+private:
+  static void report(const char* level, const char* fmt, va_list ap) {
+    fprintf(stderr, "%s: ", level);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+  }
+};
+
+static bool unset(const Geo& g) { return g.lat == 0 && g.lon == 0; }
+
+// crossing-number test in the course frame
+static bool contains(const Db& db, const CourseRec& c, const HoleRec& h) {
+  geo::Vec2 p = c.frame.toLocal(h.pin);
+  bool in = false;
+  for (uint32_t i = 0, j = h.nGreen - 1; i < h.nGreen; j = i++) {
+    geo::Vec2 a = c.frame.toLocal(db.points[h.green + j]);
+    geo::Vec2 b = c.frame.toLocal(db.points[h.green + i]);
+    if ((b.y > p.y) != (a.y > p.y) &&
+        p.x < (a.x - b.x) * (p.y - b.y) / (a.y - b.y) + b.x)
+      in = !in;
+  }
+  return in;
+}
+
+static constexpr float SAME_PIN_M        = 2.0f;
+static constexpr float PIN_FROM_LOC_M    = 2000.0f;
+static constexpr float EDGE_FROM_PIN_M   = 80.0f;
+static constexpr float MIN_HOLE_M        = 40.0f;
+static constexpr float MAX_HOLE_M        = 700.0f;
+static constexpr float HAZARD_FROM_PIN_M = 600.0f;
+
+static void validate(const Db& db, Diag& diag) {
+  for (const CourseRec& c : db.courses) {
+    const char* name = &db.strings[c.name];
+    if (!*name) diag.error("course %zu has no name", size_t(&c - db.courses.data()));
+    if (unset(c.location)) diag.error("%s: no location", name);
+    if (!c.nHoles) diag.warn("%s: no holes", name);
+
+    // image records count holes, hazards and points in 16 bits
+    size_t hazards = 0, points = c.nBoundary;
+    for (uint32_t i = 0; i < c.nHoles; ++i) {
+      hazards += db.holes[c.holes + i].nHazards;
+      points  += db.holes[c.holes + i].nLayups + db.holes[c.holes + i].nGreen;
+    }
+    if (c.nHoles > UINT16_MAX || hazards > UINT16_MAX || points > UINT16_MAX)
+      diag.error("%s: too many holes, hazards or points for the image", name);
+
+    for (uint32_t i = 0; i < c.nHoles; ++i) {
+      const HoleRec& h = db.holes[c.holes + i];
+      int n = int(i + 1);
+      if (h.number != n)
+        diag.warn("%s hole %d: numbered %d", name, n, h.number);
+      if (h.par < 3 || h.par > 6)
+        diag.warn("%s hole %d: par %d", name, n, h.par);
+
+      if (unset(h.pin)) {
+        diag.error("%s hole %d: no pin", name, n);
+        continue;
+      }
+      float fromLoc = geo::distance(c.location, h.pin);
+      if (fromLoc > PIN_FROM_LOC_M)
+        diag.warn("%s hole %d: pin %.0f m from the course location", name, n,
+                  fromLoc);
+      for (uint32_t j = 0; j < i; ++j)
+        if (c.frame.distance(h.pin, db.holes[c.holes + j].pin) < SAME_PIN_M) {
+          diag.warn("%s hole %d: pin same as hole %u", name, n, j + 1);
+          break;
+        }
+
+      const char* edgeName[] = { "front", "back" };
+      const Geo*  edge[]     = { &h.front, &h.back };
+      for (int e = 0; e < 2; ++e) {
+        if (unset(*edge[e])) {
+          diag.warn("%s hole %d: no %s", name, n, edgeName[e]);
+          continue;
+        }
+        float d = c.frame.distance(h.pin, *edge[e]);
+        if (d > EDGE_FROM_PIN_M)
+          diag.warn("%s hole %d: %s %.0f m from the pin", name, n,
+                    edgeName[e], d);
+      }
+
+      if (h.hasTee) {
+        float len = c.frame.distance(h.tee, h.pin);
+        if (len < MIN_HOLE_M || len > MAX_HOLE_M)
+          diag.warn("%s hole %d: %.0f m tee to pin", name, n, len);
+        if (!unset(h.front) && !unset(h.back) &&
+            c.frame.distance(h.tee, h.front) > c.frame.distance(h.tee, h.back))
+          diag.warn("%s hole %d: front is further from the tee than back",
+                    name, n);
+      }
+
+      if (h.nGreen && h.nGreen < 3)
+        diag.warn("%s hole %d: green outline has %u points", name, n, h.nGreen);
+      else if (h.nGreen > GreenOutline::MAX_POINTS)
+        diag.warn("%s hole %d: green outline has %u points, the device takes "
+                  "%zu and will use front/back", name, n, h.nGreen,
+                  GreenOutline::MAX_POINTS);
+      else if (h.nGreen && !contains(db, c, h))
+        diag.warn("%s hole %d: pin is outside the green outline", name, n);
+
+      // pin, front and back take the first three slots
+      size_t targets = 3 + size_t(h.nHazards) + h.nLayups;
+      if (targets > TargetTable::MAX_TARGETS)
+        diag.warn("%s hole %d: %zu targets, the device shows the first %zu",
+                  name, n, targets, TargetTable::MAX_TARGETS);
+
+      for (uint32_t z = 0; z < h.nHazards; ++z) {
+        const HazardRec& hz = db.hazards[h.hazards + z];
+        const char* type = hz.label.empty() ? "hazard" : hz.label.c_str();
+        if (hz.type == HazardType::Other && !hz.label.empty())
+          diag.warn("%s hole %d: hazard type \"%s\" shown as \"%s\"", name, n,
+                    type, hazardName(HazardType::Other));
+        if (hz.radius < 0)
+          diag.error("%s hole %d: %s radius %g", name, n, type, hz.radius);
+        float d = c.frame.distance(h.pin, hz.loc);
+        if (d > HAZARD_FROM_PIN_M)
+          diag.warn("%s hole %d: %s %.0f m from the pin", name, n, type, d);
+      }
+    }
+  }
+}
+
+// —— Course image ——
+
+template <typename T>
+static void put(std::vector<uint8_t>& out, const T& rec) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&rec);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+static size_t hazardCount(const Db& db, const CourseRec& c) {
+  size_t n = 0;
+  for (uint32_t i = 0; i < c.nHoles; ++i) n += db.holes[c.holes + i].nHazards;
+  return n;
+}
+
+static size_t pointCount(const Db& db, const CourseRec& c) {
+  size_t n = c.nBoundary;
+  for (uint32_t i = 0; i < c.nHoles; ++i)
+    n += db.holes[c.holes + i].nLayups + db.holes[c.holes + i].nGreen;
+  return n;
+}
+
+static size_t blockBytes(const Db& db, const CourseRec& c) {
+  return c.nHoles * sizeof(courseimg::HoleRecord)
+       + hazardCount(db, c) * sizeof(courseimg::HazardRecord)
+       + pointCount(db, c) * sizeof(Geo);
+}
+
+// Layout in CourseImage.h; the blocks are sized first so the string table's
+// offset is known before any record refers to it.
+static std::vector<uint8_t> image(const Db& db) {
+  using namespace courseimg;
+  const size_t n = db.courses.size();
+
+  Header hdr{};
+  hdr.magic   = MAGIC;
+  hdr.version = VERSION;
+  hdr.count   = uint32_t(n);
+  hdr.entries = sizeof(Header);
+  hdr.tree    = hdr.entries + uint32_t(n * sizeof(Entry));
+
+  std::vector<Entry> entries(n);
+  std::vector<Geo>   locations(n);
+  uint32_t at = hdr.tree + uint32_t(n * CourseIndex::NODE_BYTES);
+  for (size_t i = 0; i < n; ++i) {
+    const CourseRec& c = db.courses[i];
+    hdr.maxHoles   = std::max(hdr.maxHoles, uint16_t(c.nHoles));
+    hdr.maxHazards = std::max(hdr.maxHazards, uint16_t(hazardCount(db, c)));
+    const geo::LocalFrame& f = c.frame;
+    Entry& e = entries[i];
+    e.location  = locations[i] = c.location;
+    e.block     = at;
+    e.holes     = uint16_t(c.nHoles);
+    e.hazards   = uint16_t(hazardCount(db, c));
+    e.points    = uint16_t(pointCount(db, c));
+    e.boundary  = uint16_t(c.nBoundary);
+    e.origin    = f.origin();
+    e.earth     = uint8_t(f.earth());
+    e.mPerE7Lat = f.mPerE7Lat();
+    e.mPerE7Lon = f.mPerE7Lon();
+    e.xSlope    = f.xSlope();
+    e.ySlope    = f.ySlope();
+    at += uint32_t(blockBytes(db, c));
+  }
+  const uint32_t strings = at;
+  hdr.size = strings + uint32_t(db.strings.size());
+  for (size_t i = 0; i < n; ++i) entries[i].name = strings + db.courses[i].name;
+
+  std::vector<uint8_t> out;
+  out.reserve(hdr.size);
+  put(out, hdr);
+  for (const Entry& e : entries) put(out, e);
+
+  CourseIndex tree;
+  tree.build(locations.data(), n);
+  const uint8_t* nodes = static_cast<const uint8_t*>(tree.data());
+  out.insert(out.end(), nodes, nodes + tree.bytes());
+
+  for (const CourseRec& c : db.courses) {
+    // points: the boundary, then each hole's layups and green
+    uint32_t hazard = 0, point = c.nBoundary;
+    for (uint32_t i = 0; i < c.nHoles; ++i) {
+      const HoleRec& h = db.holes[c.holes + i];
+      HoleRecord r{};
+      r.number   = uint16_t(h.number);
+      r.par      = uint8_t(h.par);
+      r.hasTee   = h.hasTee;
+      r.pin      = h.pin;
+      r.front    = h.front;
+      r.back     = h.back;
+      r.tee      = h.tee;
+      r.hazards  = uint16_t(hazard);
+      r.nHazards = uint16_t(h.nHazards);
+      r.layups   = uint16_t(point);
+      r.nLayups  = uint16_t(h.nLayups);
+      r.green    = uint16_t(point + h.nLayups);
+      r.nGreen   = uint16_t(h.nGreen);
+      hazard += h.nHazards;
+      point  += h.nLayups + h.nGreen;
+      put(out, r);
+    }
+    for (uint32_t i = 0; i < c.nHoles; ++i) {
+      const HoleRec& h = db.holes[c.holes + i];
+      for (uint32_t k = 0; k < h.nHazards; ++k) {
+        const HazardRec& z = db.hazards[h.hazards + k];
+        put(out, HazardRecord{ z.loc, z.radius, uint8_t(z.type), {} });
+      }
+    }
+    for (uint32_t k = 0; k < c.nBoundary; ++k) put(out, db.points[c.boundary + k]);
+    for (uint32_t i = 0; i < c.nHoles; ++i) {
+      const HoleRec& h = db.holes[c.holes + i];
+      for (uint32_t k = 0; k < h.nLayups; ++k) put(out, db.points[h.layups + k]);
+      for (uint32_t k = 0; k < h.nGreen; ++k)  put(out, db.points[h.green + k]);
+    }
+  }
+  out.insert(out.end(), db.strings.begin(), db.strings.end());
+  return out;
+}
+
+// —— Emit courses_db.h ——
+
+static void emit(FILE* out, const std::vector<uint8_t>& img, const char* source) {
+  fprintf(out,
+    "// courses_db.h — generated by tools/course_compiler from %s.\n"
+    "// Do not edit; rerun the compiler after changing the course JSON.\n"
+    "//\n"
+    "// The course image (CourseImage.h) built into the firmware, for when the\n"
+    "// \"courses\" flash partition holds none.\n"
+    "#pragma once\n\n"
+    "#include <stdint.h>\n\n"
+    "namespace coursedb {\n\n"
+    "alignas(4) static const uint8_t IMAGE[%zu] = {\n", source, img.size());
+  for (size_t i = 0; i < img.size(); i += 16) {
+    fprintf(out, " ");
+    for (size_t k = i; k < img.size() && k < i + 16; ++k)
+      fprintf(out, " 0x%02x,", img[k]);
+    fprintf(out, "\n");
+  }
+  fprintf(out, "};\n\n}  // namespace coursedb\n");
+}
+
+static bool writeFile(const char* path, const std::vector<uint8_t>& img) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(img.data(), 1, img.size(), f) == img.size();
+  return fclose(f) == 0 && ok;
+}
+
+// —— Footprint ——
+
+// sizeof() on the ESP32 (ILP32): pointers and size_t are 4 bytes
+static constexpr size_t ESP_HAZARD = 16;   // loc, radius, type
+static constexpr size_t ESP_HOLE   = 68;   // 2 int, 4 Geo, bool, 3 Span
+
+// HolePage::buildHoleIndex()
+static void buildHoleIndex(const Course& c, HoleIndex& index) {
+  for (const Hole& h : c.holes)
+    index.add(c.frame.toLocal(h.tee), c.frame.toLocal(h.pin));
+  index.build();
+}
+
+// Flash is the course's share of the image; RAM is what CoursesManager
+// decodes and HolePage builds while it is being played.
+static void report(const Db& db, const CourseImage& img) {
+  fprintf(stderr, "%-28s %5s %5s %6s %9s %9s %9s\n", "course", "holes", "haz",
+          "points", "flash B", "decoded B", "grid B");
+  size_t peak = 0;
+  Arena arena;
+  arena.reserve(img.arenaBytes());
+  for (size_t i = 0; i < db.courses.size(); ++i) {
+    const CourseRec& c = db.courses[i];
+    size_t flash = sizeof(courseimg::Entry) + CourseIndex::NODE_BYTES
+                 + blockBytes(db, c) + strlen(&db.strings[c.name]) + 1;
+    size_t ram = c.nHoles * ESP_HOLE + hazardCount(db, c) * ESP_HAZARD;
+
+    Course course;
+    HoleIndex index;
+    if (img.decode(i, course, arena)) buildHoleIndex(course, index);
+    peak = std::max(peak, ram + index.bytes());
+    fprintf(stderr, "%-28.28s %5u %5zu %6zu %9zu %9zu %9zu\n",
+            &db.strings[c.name], c.nHoles, hazardCount(db, c),
+            pointCount(db, c), flash, ram, index.bytes());
+  }
+  fprintf(stderr, "image %zu B; RAM for the largest course %zu B, whatever "
+          "the library size\n", img.bytes(), peak);
+}
+
+// —— Benchmark ——
+
+using Clock = std::chrono::steady_clock;
+
+// Feed `n` bytes in SD-sized reads, as the device would
+template <typename Reader>
+static bool stream(Reader& r, const char* p, size_t n) {
+  static constexpr size_t CHUNK = 4096;
+  for (size_t at = 0; at < n; at += CHUNK)
+    if (!r.feed(p + at, std::min(CHUNK, n - at))) return false;
+  return r.finish();
+}
+
+// Mean ns per call of `fn` over at least 200 ms
+template <typename Fn>
+static double timeIt(Fn fn) {
+  size_t runs = 0;
+  auto t0 = Clock::now();
+  double ns;
+  do {
+    fn();
+    ++runs;
+    ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+  } while (ns < 2e8);
+  return ns / double(runs);
+}
+
+static volatile uint32_t sink;
+
+// Parsing, then everything CoursesManager and HolePage do with the image
+static void bench(const char* json, size_t len, const uint8_t* data, size_t n) {
+  // the bare reader, then with course records built as for an SD import
+  JsonReader::Handler none;
+  double sax = timeIt([&] {
+    JsonReader r(none);
+    sink = stream(r, json, len);
+  });
+  size_t biggest = 0;
+  double build = timeIt([&] {
+    CourseJsonReader r([&](const JsonCourse& c) {
+      biggest = std::max(biggest, c.holes.size());
+    });
+    sink = stream(r, json, len);
+  });
+
+  CourseImage img;
+  double open = timeIt([&] { sink = img.open(data, n); });
+
+  std::vector<Course> courses(img.size());
+  std::vector<Arena>  arenas(img.size());
+  for (size_t i = 0; i < img.size(); ++i) {
+    arenas[i].reserve(img.arenaBytes());
+    img.decode(i, courses[i], arenas[i]);
+  }
+
+  Course course;
+  Arena arena;
+  arena.reserve(img.arenaBytes());
+  size_t q = 0;
+  double decode = img.size() ? timeIt([&] {
+    sink = img.decode(q++ % img.size(), course, arena);
+  }) : 0;
+  q = 0;
+  double grid = img.size() ? timeIt([&] {
+    HoleIndex index;
+    buildHoleIndex(courses[q++ % courses.size()], index);
+    sink = uint32_t(index.size());
+  }) : 0;
+
+  // queries scattered within 5 km of the courses / 500 m of their pins
+  uint32_t seed = 1;
+  auto rnd = [&seed](int32_t span) {
+    seed = seed * 1664525u + 1013904223u;
+    return int32_t(seed >> 8) % span - span / 2;
+  };
+  std::vector<Geo> near;
+  for (size_t i = 0; i < 1024 && img.size(); ++i) {
+    Geo g = img.location(i % img.size());
+    near.push_back(Geo{ g.lat + rnd(900000), g.lon + rnd(900000) });
+  }
+  uint32_t ids[20];
+  q = 0;
+  double nearest = near.empty() ? 0 : timeIt([&] {
+    sink = uint32_t(img.nearest(near[q++ & 1023], 20, ids));
+  });
+
+  std::vector<HoleIndex> grids(courses.size());
+  std::vector<std::pair<size_t, geo::Vec2>> onCourse;
+  for (size_t i = 0; i < courses.size(); ++i) {
+    buildHoleIndex(courses[i], grids[i]);
+    for (const Hole& hole : courses[i].holes) {
+      geo::Vec2 p = courses[i].frame.toLocal(hole.pin);
+      for (int k = 0; k < 16; ++k)
+        onCourse.emplace_back(i, geo::Vec2{ p.x + float(rnd(1000)),
+                                            p.y + float(rnd(1000)) });
+    }
+  }
+  q = 0;
+  double locate = onCourse.empty() ? 0 : timeIt([&] {
+    const auto& e = onCourse[q++ % onCourse.size()];
+    sink = uint32_t(grids[e.first].locate(e.second));
+  });
+
+  fprintf(stderr,
+          "read JSON          %10.1f MB/s  (%zu B reader)\n"
+          "build courses      %10.1f MB/s  (%zu B reader + one course)\n"
+          "open image         %10.1f ns\n"
+          "decode course      %10.1f ns\n"
+          "build HoleIndex    %10.1f ns\n"
+          "nearest(20)        %10.1f ns\n"
+          "locate             %10.1f ns\n",
+          len / sax * 1e3, sizeof(JsonReader), len / build * 1e3,
+          sizeof(CourseJsonReader), open, decode, grid, nearest, locate);
+}
+
+// Input and image as the device sees them: mapped, not read
+static const uint8_t* mapFile(const char* path, size_t& n) {
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return nullptr;
+  struct stat st;
+  void* p = fstat(fd, &st) == 0
+          ? mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+          : MAP_FAILED;
+  close(fd);
+  if (p == MAP_FAILED) return nullptr;
+  n = size_t(st.st_size);
+  return static_cast<const uint8_t*>(p);
+}
+
+static void usage(const char* argv0) {
+  fprintf(stderr, "usage: %s [--strict] [--report] [--bench] [-o courses_db.h] "
+          "[--image courses.bin] courses.json|courses_data.h\n", argv0);
+}
+
+int main(int argc, char** argv) {
+  bool strict = false, wantReport = false, wantBench = false;
+  const char* path = nullptr;
+  const char* outPath = nullptr;
+  const char* imagePath = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if      (!strcmp(argv[i], "--strict")) strict = true;
+    else if (!strcmp(argv[i], "--report")) wantReport = true;
+    else if (!strcmp(argv[i], "--bench"))  wantBench = true;
+    else if (!strcmp(argv[i], "-o") && i + 1 < argc) outPath = argv[++i];
+    else if (!strcmp(argv[i], "--image") && i + 1 < argc) imagePath = argv[++i];
+    else if (argv[i][0] != '-' && !path) path = argv[i];
+    else { usage(argv[0]); return 2; }
+  }
+  if (!path) { usage(argv[0]); return 2; }
+
+  size_t size = 0;
+  const char* text = reinterpret_cast<const char*>(mapFile(path, size));
+  if (!text) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return 1;
+  }
+
+  // pull the JSON out of a raw string literal if there is one
+  const char* json = text;
+  size_t len = size;
+  static const char OPEN[] = "R\"RAWJSON(", CLOSE[] = ")RAWJSON\"";
+  const char* at = std::search(text, text + size, OPEN, OPEN + strlen(OPEN));
+  if (at != text + size) {
+    json = at + strlen(OPEN);
+    const char* end = std::search(json, text + size, CLOSE, CLOSE + strlen(CLOSE));
+    if (end == text + size) {
+      fprintf(stderr, "%s: unterminated RAWJSON literal\n", path);
+      return 1;
+    }
+    len = size_t(end - json);
+  }
+  const size_t base = size_t(json - text);
+
+  // courses are compiled as they stream past; bad points are errors
+  Diag diag;
+  Db db;
+  CourseJsonReader reader(
+    [&db](const JsonCourse& c) { compile(c, db); },
+    [&](size_t offset, const char* what) {
+      diag.error("byte %zu: %s", base + offset, what);
+    });
+  if (!stream(reader, json, len)) {
+    fprintf(stderr, "%s: byte %zu: %s\n", path, base + reader.offset(),
+            reader.error());
+    return 1;
+  }
+  if (diag.errors) {
+    fprintf(stderr, "%s: %d errors\n", path, diag.errors);
+    return 1;
+  }
+  sortByName(db);
+  validate(db, diag);
+  fprintf(stderr, "%zu courses, %zu holes, %zu hazards, %zu points, "
+          "%zu string bytes; %d errors, %d warnings\n", db.courses.size(),
+          db.holes.size(), db.hazards.size(), db.points.size(),
+          db.strings.size(), diag.errors, diag.warnings);
+  if (diag.errors || (strict && diag.warnings)) return 1;
+
+  std::vector<uint8_t> img = image(db);
+  if (imagePath && !writeFile(imagePath, img)) {
+    fprintf(stderr, "%s: cannot write\n", imagePath);
+    return 1;
+  }
+
+  // report and bench read the image back, from the file when there is one
+  const uint8_t* data = img.data();
+  size_t bytes = img.size();
+  if (imagePath && !(data = mapFile(imagePath, bytes))) {
+    fprintf(stderr, "%s: cannot map\n", imagePath);
+    return 1;
+  }
+  CourseImage readBack;
+  if (!readBack.open(data, bytes)) {
+    fprintf(stderr, "image does not read back\n");
+    return 1;
+  }
+  if (wantReport) report(db, readBack);
+  if (wantBench)  bench(json, len, data, bytes);
+
+  FILE* out = outPath ? fopen(outPath, "w") : stdout;
+  if (!out) {
+    fprintf(stderr, "%s: cannot write\n", outPath);
+    return 1;
+  }
+  const char* name = strrchr(path, '/');
+  emit(out, img, name ? name + 1 : path);
+  if (outPath && fclose(out)) {
+    fprintf(stderr, "%s: write failed\n", outPath);
+    return 1;
+  }
+  return 0;
+}
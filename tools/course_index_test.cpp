@@ -0,0 +1,201 @@
+// course_index_test.cpp — CourseIndex::nearest() against a brute-force
+// ranking of every course, on a 50k-course library, then build and query
+// cost next to the full sort it replaced.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o course_index_test course_index_test.cpp ../CourseIndex.cpp ../Geo.cpp
+//
+// The library clusters round a few hundred towns the way real ones do,
+// with a sprinkling everywhere else, and some courses placed on the
+// antimeridian and near the poles, where a lat/lon tree would go wrong.
+// Exits non-zero if any check fails.
+#include "CourseIndex.h"
+#include "host_check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+static constexpr double RAD = M_PI / 180.0;
+
+// Great-circle distance in metres, in double, as the ranking to match.
+static double arc(const Geo& a, const Geo& b) {
+  double la = geo::toDegrees(a.lat) * RAD, lb = geo::toDegrees(b.lat) * RAD;
+  double dl = geo::toDegrees(geo::deltaLon(a.lon, b.lon)) * RAD;
+  double h = sin((lb - la) / 2) * sin((lb - la) / 2) +
+             cos(la) * cos(lb) * sin(dl / 2) * sin(dl / 2);
+  return 2.0 * 6'371'000.0 * asin(sqrt(fmin(h, 1.0)));
+}
+
+static Geo around(const Geo& c, double km, Rng& rng) {
+  double lat = geo::toDegrees(c.lat) + rng.normal(km / 111.2);
+  double lon = geo::toDegrees(c.lon) +
+               rng.normal(km / 111.2) / fmax(0.05, cos(lat * RAD));
+  lat = fmax(-89.9, fmin(89.9, lat));
+  while (lon > 180) lon -= 360;
+  while (lon < -180) lon += 360;
+  return geo::fromDegrees(lat, lon);
+}
+
+static std::vector<Geo> library(size_t n, Rng& rng) {
+  std::vector<Geo> towns;
+  for (int i = 0; i < 400; ++i)
+    towns.push_back(geo::fromDegrees(rng.uniform(-55, 65), rng.uniform(-180, 180)));
+  // awkward places: both sides of the antimeridian, both poles
+  towns.push_back(geo::fromDegrees(-17.8, 179.95));
+  towns.push_back(geo::fromDegrees(-17.8, -179.95));
+  towns.push_back(geo::fromDegrees(89.5, 0));
+  towns.push_back(geo::fromDegrees(-89.5, 120));
+
+  std::vector<Geo> out;
+  while (out.size() < n) {
+    if (rng.next() % 10 == 0)
+      out.push_back(geo::fromDegrees(rng.uniform(-80, 80), rng.uniform(-180, 180)));
+    else
+      out.push_back(around(towns[rng.next() % towns.size()], 30, rng));
+  }
+  return out;
+}
+
+// Brute force: every course ranked by true distance, nearest k.
+static std::vector<double> bruteForce(const std::vector<Geo>& lib, const Geo& q,
+                                      size_t k) {
+  std::vector<double> d;
+  d.reserve(lib.size());
+  for (const Geo& g : lib) d.push_back(arc(q, g));
+  k = std::min(k, d.size());
+  std::partial_sort(d.begin(), d.begin() + k, d.end());
+  d.resize(k);
+  return d;
+}
+
+// The index agrees with the brute force when it returns as many distinct
+// ids and the i-th is as near as the i-th true nearest.  Ids alone can
+// differ between courses a float's width apart (about a metre on the
+// unit sphere), so distances are compared with that slack.
+static bool agrees(const std::vector<Geo>& lib, const Geo& q, const uint32_t* ids,
+                   size_t n, const std::vector<double>& want) {
+  if (n != want.size()) return false;
+  std::vector<uint32_t> seen(ids, ids + n);
+  std::sort(seen.begin(), seen.end());
+  if (std::adjacent_find(seen.begin(), seen.end()) != seen.end()) return false;
+  for (size_t i = 0; i < n; ++i) {
+    if (ids[i] >= lib.size()) return false;
+    if (fabs(arc(q, lib[ids[i]]) - want[i]) > 2.0) return false;
+  }
+  return true;
+}
+
+static void equivalence(const std::vector<Geo>& lib, const CourseIndex& ix,
+                        Rng& rng) {
+  static const size_t KS[] = { 1, 5, 20 };
+  uint32_t ids[20];
+  size_t queries = 0, bad = 0;
+  for (int i = 0; i < 600; ++i) {
+    Geo q;
+    switch (i % 4) {
+      case 0: q = geo::fromDegrees(rng.uniform(-90, 90), rng.uniform(-180, 180)); break;
+      case 1: q = around(lib[rng.next() % lib.size()], 5, rng); break;
+      case 2: q = lib[rng.next() % lib.size()]; break;                       // on a course
+      case 3: q = geo::fromDegrees(rng.uniform(-20, -15),                     // antimeridian
+                                   rng.next() & 1 ? 179.99 : -179.99); break;
+    }
+    std::vector<double> all = bruteForce(lib, q, 20);
+    for (size_t k : KS) {
+      size_t n = ix.nearest(q, k, ids);
+      std::vector<double> want(all.begin(), all.begin() + std::min(k, all.size()));
+      bool ok = agrees(lib, q, ids, n, want);
+      if (i % 4 == 2) ok = ok && arc(q, lib[ids[0]]) == 0.0;
+      bad += !ok;
+      ++queries;
+    }
+  }
+  printf("%zu courses: %zu k-nearest queries (k = 1, 5, 20), %zu differ from "
+         "brute force\n", lib.size(), queries, bad);
+  CHECK(bad == 0);
+}
+
+static void edges(Rng& rng) {
+  uint32_t ids[8];
+  CourseIndex ix;
+  ix.build(nullptr, 0);
+  CHECK(ix.size() == 0 && ix.nearest(Geo{}, 3, ids) == 0);
+
+  std::vector<Geo> three = library(3, rng);
+  ix.build(three.data(), three.size());
+  CHECK(ix.nearest(three[1], 8, ids) == 3);      // k past the library
+  CHECK(ids[0] == 1);
+  CHECK(ix.nearest(three[1], 0, ids) == 0);
+
+  // stored and attached, as a course image carries it
+  std::vector<Geo> lib = library(5000, rng);
+  ix.build(lib.data(), lib.size());
+  std::unique_ptr<uint32_t[]> copy(new uint32_t[ix.bytes() / 4]);
+  memcpy(copy.get(), ix.data(), ix.bytes());
+  CourseIndex attached;
+  attached.attach(copy.get(), lib.size());
+  CHECK(attached.size() == lib.size());
+  size_t same = 0;
+  for (int i = 0; i < 200; ++i) {
+    Geo q = geo::fromDegrees(rng.uniform(-90, 90), rng.uniform(-180, 180));
+    uint32_t a[8], b[8];
+    size_t na = ix.nearest(q, 8, a), nb = attached.nearest(q, 8, b);
+    same += na == nb && std::equal(a, a + na, b);
+  }
+  CHECK(same == 200);
+
+  // the same locations give the same bytes
+  CourseIndex again;
+  again.build(lib.data(), lib.size());
+  CHECK(again.bytes() == ix.bytes() && !memcmp(again.data(), ix.data(), ix.bytes()));
+}
+
+static void benchmark(const std::vector<Geo>& lib, Rng& rng) {
+  CourseIndex ix;
+  double buildNs = nsPer(5, [&](size_t) { ix.build(lib.data(), lib.size()); });
+
+  std::vector<Geo> qs;
+  for (int i = 0; i < 1024; ++i) qs.push_back(around(lib[rng.next() % lib.size()], 20, rng));
+  uint32_t ids[20], acc = 0;
+  printf("%zu courses: build %.1f ms, %zu B;", lib.size(), buildNs / 1e6, ix.bytes());
+  for (size_t k : { 1, 5, 20 }) {
+    double ns = nsPer(200'000, [&](size_t i) {
+      ix.nearest(qs[i & 1023], k, ids);
+      acc += ids[0];
+    });
+    printf(" k=%zu %.2f us", k, ns / 1e3);
+  }
+  // what CoursesPage did before the index: sort every course by its
+  // squared lat/lon offset
+  std::vector<uint32_t> order(lib.size());
+  double sortNs = nsPer(20, [&](size_t i) {
+    const Geo& q = qs[i & 1023];
+    auto dist2 = [&](const Geo& g) {
+      int64_t dlat = g.lat - q.lat;
+      int64_t dlon = geo::deltaLon(q.lon, g.lon);
+      return dlat * dlat + dlon * dlon;
+    };
+    for (uint32_t j = 0; j < order.size(); ++j) order[j] = j;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return dist2(lib[a]) < dist2(lib[b]);
+    });
+    acc += order[0];
+  });
+  keep(acc);
+  printf("; sorting every course %.1f ms\n", sortNs / 1e6);
+}
+
+int main(int, char** argv) {
+  Rng rng(53);
+  std::vector<Geo> lib = library(50'000, rng);
+  CourseIndex ix;
+  ix.build(lib.data(), lib.size());
+  CHECK(ix.size() == lib.size());
+
+  equivalence(lib, ix, rng);
+  edges(rng);
+  benchmark(lib, rng);
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,159 @@
+// fastmath_sweep.cpp — worst-case error of every FastMath.h kernel and
+// tier, against double-precision libm on the same float inputs, and what
+// each call costs next to the float libm call it replaces.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o fastmath_sweep fastmath_sweep.cpp
+//
+//   fastmath_sweep [--quick]
+//
+// Inputs are walked float by float, not sampled:
+//   sin/cos  every float with 2^-12 <= |x| < 16 rad, both signs (below
+//            that sin x is x to well inside every bound; every 4096th
+//            float there is still checked)
+//   atan2    every ratio z in [2^-12, 1] in four octants, (z, 1), (1, z),
+//            (z, -1) and (-1, -z), plus every 4096th smaller z
+//   sqrt     every float in [1, 4); the error repeats exactly for every
+//            other factor of four, so that is every normal float
+// --quick takes every 64th float instead, in a few seconds.  The table in
+// FastMath.h is this program's output; exits non-zero if a kernel misses
+// the bound tierFor() promises for its tier, or High its table entry.
+#include "FastMath.h"
+#include "host_check.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+using fm::Tier;
+
+static uint32_t bitsOf(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static float floatOf(uint32_t u) {
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+// every `step`th positive float in [lo, hi)
+template <typename F>
+static void walk(float lo, float hi, uint32_t step, F&& f) {
+  for (uint32_t u = bitsOf(lo), end = bitsOf(hi); u < end; u += step)
+    f(floatOf(u));
+}
+
+struct Worst {
+  double err = 0;
+  double at  = 0;
+  void see(double e, double x) {
+    if (e > err) {
+      err = e;
+      at  = x;
+    }
+  }
+};
+
+static double angleErr(double a, double b) {
+  double e = fabs(a - b);
+  return e > M_PI ? 2 * M_PI - e : e;
+}
+
+template <Tier T>
+static Worst sinCos(uint32_t step) {
+  Worst w;
+  auto one = [&](float x) {
+    for (float s : { x, -x }) {
+      w.see(fabs(fm::sin<T>(s) - sin(double(s))), s);
+      w.see(fabs(fm::cos<T>(s) - cos(double(s))), s);
+    }
+  };
+  walk(0x1p-12f, 16.0f, step, one);
+  walk(0x1p-126f, 0x1p-12f, step * 4096, one);
+  return w;
+}
+
+template <Tier T>
+static Worst atan2(uint32_t step) {
+  Worst w;
+  auto one = [&](float z) {
+    w.see(angleErr(fm::atan2<T>(z, 1.0f), atan2(double(z), 1.0)), z);
+    w.see(angleErr(fm::atan2<T>(1.0f, z), atan2(1.0, double(z))), z);
+    w.see(angleErr(fm::atan2<T>(z, -1.0f), atan2(double(z), -1.0)), z);
+    w.see(angleErr(fm::atan2<T>(-1.0f, -z), atan2(-1.0, -double(z))), z);
+  };
+  walk(0x1p-12f, 1.0f, step, one);
+  one(1.0f);
+  walk(0x1p-126f, 0x1p-12f, step * 4096, one);
+  return w;
+}
+
+template <Tier T>
+static Worst sqrtRel(uint32_t step) {
+  Worst w;
+  walk(1.0f, 4.0f, step, [&](float x) {
+    w.see(fabs(fm::sqrt<T>(x) / sqrt(double(x)) - 1.0), x);
+  });
+  return w;
+}
+
+// what tierFor() assumes Low and Mid stay within; High has no tier
+// above it, so hold it to the documented table with a little room
+static double bound(Tier t) {
+  return t == Tier::Low ? 5e-3 : t == Tier::Mid ? 3e-5 : 2e-6;
+}
+
+template <Tier T>
+static void tier(const char* name, uint32_t step) {
+  Worst s = sinCos<T>(step), a = atan2<T>(step), q = sqrtRel<T>(step);
+  printf("  %-4s   %.1e (x %+8.4f)   %.1e (z %.4f)   %.1e\n", name, s.err,
+         s.at, a.err, a.at, q.err);
+  CHECK(s.err < bound(T));
+  CHECK(a.err < bound(T));
+  CHECK(q.err < bound(T) || T == Tier::High);
+}
+
+// ns per call over angles / ratios the firmware actually sees
+template <typename F>
+static double cost(F&& f) {
+  float acc = 0;
+  double ns = nsPer(10'000'000, [&](size_t i) {
+    acc += f(float(i) * 3e-7f - 1.5f);
+  });
+  keep(acc);
+  return ns;
+}
+
+template <Tier T>
+static void timing(const char* name) {
+  printf("  %-4s  %6.2f  %6.2f  %6.2f\n", name,
+         cost([](float x) { return fm::sin<T>(x); }),
+         cost([](float x) { return fm::atan2<T>(x, 1.0f - x); }),
+         cost([](float x) { return fm::sqrt<T>(x + 2.0f); }));
+}
+
+int main(int argc, char** argv) {
+  uint32_t step = argc > 1 && !strcmp(argv[1], "--quick") ? 64 : 1;
+
+  printf("worst error (sin/cos, atan2 absolute in rad; sqrt relative)%s\n",
+         step > 1 ? ", every 64th float" : "");
+  printf("  tier   sin/cos abs              atan2 abs              sqrt rel\n");
+  tier<Tier::Low>("Low", step);
+  tier<Tier::Mid>("Mid", step);
+  tier<Tier::High>("High", step);
+
+  printf("\nns per call\n  tier     sin   atan2    sqrt\n");
+  timing<Tier::Low>("Low");
+  timing<Tier::Mid>("Mid");
+  timing<Tier::High>("High");
+  printf("  libm  %6.2f  %6.2f  %6.2f\n",
+         cost([](float x) { return sinf(x); }),
+         cost([](float x) { return atan2f(x, 1.0f - x); }),
+         cost([](float x) { return sqrtf(x + 2.0f); }));
+
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,188 @@
+// geo_check.cpp — Geo.h's distances against double-precision references:
+// LocalFrame(Earth::Wgs84) against Vincenty's inverse on the ellipsoid,
+// LocalFrame(Earth::Sphere) and geo::distance() against haversine on the
+// same 6371 km sphere, then what each costs per call.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o geo_check geo_check.cpp ../Geo.cpp
+//
+// Pairs are drawn the way a round uses them: both ends within 3 km of a
+// course origin, up to 600 m apart, at latitudes from the equator to the
+// Arctic circle.  Exits non-zero if any check fails.
+#include "Geo.h"
+#include "host_check.h"
+
+#include <cmath>
+#include <vector>
+
+// —— References ——
+
+static constexpr double R_SPHERE = 6'371'000.0;
+static constexpr double WGS84_A  = 6378137.0;
+static constexpr double WGS84_F  = 1.0 / 298.257223563;
+static constexpr double RAD      = M_PI / 180.0;
+
+static double haversine(const Geo& a, const Geo& b) {
+  double la = geo::toDegrees(a.lat) * RAD, lb = geo::toDegrees(b.lat) * RAD;
+  double dLat = (lb - la) * 0.5;
+  double dLon = geo::toDegrees(geo::deltaLon(a.lon, b.lon)) * RAD * 0.5;
+  double h = sin(dLat) * sin(dLat) + cos(la) * cos(lb) * sin(dLon) * sin(dLon);
+  return 2.0 * R_SPHERE * asin(sqrt(fmin(h, 1.0)));
+}
+
+// Vincenty (1975) inverse: geodesic length on the WGS84 ellipsoid, good to
+// well under a millimetre for anything short of near-antipodal points.
+static double vincenty(const Geo& a, const Geo& b) {
+  const double bAxis = WGS84_A * (1.0 - WGS84_F);
+  double L  = geo::toDegrees(geo::deltaLon(a.lon, b.lon)) * RAD;
+  double U1 = atan((1.0 - WGS84_F) * tan(geo::toDegrees(a.lat) * RAD));
+  double U2 = atan((1.0 - WGS84_F) * tan(geo::toDegrees(b.lat) * RAD));
+  double sU1 = sin(U1), cU1 = cos(U1), sU2 = sin(U2), cU2 = cos(U2);
+
+  double lambda = L, sSigma = 0, cSigma = 1, sigma = 0, c2Alpha = 1, c2Sm = 0;
+  for (int i = 0; i < 200; ++i) {
+    double sL = sin(lambda), cL = cos(lambda);
+    sSigma = sqrt((cU2 * sL) * (cU2 * sL) +
+                  (cU1 * sU2 - sU1 * cU2 * cL) * (cU1 * sU2 - sU1 * cU2 * cL));
+    if (sSigma == 0) return 0;
+    cSigma  = sU1 * sU2 + cU1 * cU2 * cL;
+    sigma   = atan2(sSigma, cSigma);
+    double sAlpha = cU1 * cU2 * sL / sSigma;
+    c2Alpha = 1.0 - sAlpha * sAlpha;
+    c2Sm    = c2Alpha ? cSigma - 2.0 * sU1 * sU2 / c2Alpha : 0.0;
+    double C = WGS84_F / 16.0 * c2Alpha * (4.0 + WGS84_F * (4.0 - 3.0 * c2Alpha));
+    double prev = lambda;
+    lambda = L + (1.0 - C) * WGS84_F * sAlpha *
+             (sigma + C * sSigma * (c2Sm + C * cSigma * (-1.0 + 2.0 * c2Sm * c2Sm)));
+    if (fabs(lambda - prev) < 1e-13) break;
+  }
+  double u2 = c2Alpha * (WGS84_A * WGS84_A - bAxis * bAxis) / (bAxis * bAxis);
+  double A  = 1.0 + u2 / 16384.0 * (4096.0 + u2 * (-768.0 + u2 * (320.0 - 175.0 * u2)));
+  double B  = u2 / 1024.0 * (256.0 + u2 * (-128.0 + u2 * (74.0 - 47.0 * u2)));
+  double dSigma = B * sSigma * (c2Sm + B / 4.0 *
+                  (cSigma * (-1.0 + 2.0 * c2Sm * c2Sm) -
+                   B / 6.0 * c2Sm * (-3.0 + 4.0 * sSigma * sSigma) *
+                   (-3.0 + 4.0 * c2Sm * c2Sm)));
+  return bAxis * A * (sigma - dSigma);
+}
+
+// —— Pairs ——
+
+struct Pair {
+  Geo a, b;
+};
+
+static const double LATS[] = { 0.3, -25.9004, 38.5, 51.48, -45.87, 57.4, 66.0 };
+
+// Both ends within 3 km of `origin`, up to 600 m apart.
+static std::vector<Pair> pairs(const Geo& origin, size_t n, Rng& rng) {
+  geo::LocalFrame f(origin);
+  std::vector<Pair> out;
+  while (out.size() < n) {
+    double r = 3000.0 * sqrt(rng.uniform()), t = rng.uniform(0, 2 * M_PI);
+    double x = r * sin(t), y = r * cos(t);
+    double d = 600.0 * rng.uniform(), h = rng.uniform(0, 2 * M_PI);
+    double x2 = x + d * sin(h), y2 = y + d * cos(h);
+    if (x2 * x2 + y2 * y2 > 3000.0 * 3000.0) continue;
+    out.push_back(Pair{ f.toGeo(geo::Vec2{ float(x), float(y) }),
+                        f.toGeo(geo::Vec2{ float(x2), float(y2) }) });
+  }
+  return out;
+}
+
+// —— Checks ——
+
+static void frames() {
+  Rng rng(17);
+  double worstWgs = 0, worstSphere = 0, worstRoute = 0, worstRel = 0;
+  int worstUnits = 0;
+  size_t checked = 0;
+  for (double lat : LATS) {
+    Geo origin = geo::fromDegrees(lat, 28.2019);
+    geo::LocalFrame wgs(origin, geo::Earth::Wgs84), sphere(origin);
+    double worstHere = 0;
+    for (const Pair& p : pairs(origin, 20'000, rng)) {
+      double v = vincenty(p.a, p.b), h = haversine(p.a, p.b);
+      double ew = fabs(wgs.distance(p.a, p.b) - v);
+      worstHere   = fmax(worstHere, ew);
+      worstWgs    = fmax(worstWgs, ew);
+      worstSphere = fmax(worstSphere, fabs(sphere.distance(p.a, p.b) - h));
+      worstRoute  = fmax(worstRoute, fabs(double(geo::distance(p.a, p.b)) - h));
+      // the sphere is what Earth::Wgs84 is there to fix
+      if (v > 1.0) worstRel = fmax(worstRel, fabs(h - v) / v);
+
+      // toGeo() undoes toLocal() to the unit
+      Geo back = wgs.toGeo(wgs.toLocal(p.b));
+      worstUnits = std::max(worstUnits, std::max(abs(back.lat - p.b.lat),
+                                                 abs(back.lon - p.b.lon)));
+      ++checked;
+    }
+    printf("  lat %8.4f: LocalFrame(Wgs84) vs Vincenty worst %.2f mm\n", lat,
+           worstHere * 1e3);
+  }
+  printf("%zu pairs up to 600 m, within 3 km of the origin:\n"
+         "  LocalFrame(Wgs84)  vs Vincenty   worst %.2f mm\n"
+         "  LocalFrame(Sphere) vs haversine  worst %.2f mm\n"
+         "  geo::distance()    vs haversine  worst %.2f mm\n"
+         "  haversine vs Vincenty (what the sphere costs) worst %.2f%%\n"
+         "  toGeo(toLocal(g)) worst %d unit(s)\n",
+         checked, worstWgs * 1e3, worstSphere * 1e3, worstRoute * 1e3,
+         worstRel * 100, worstUnits);
+  CHECK(worstWgs < 1e-3);
+  CHECK(worstSphere < 1e-3);
+  CHECK(worstRoute < 1e-3);
+  CHECK(worstRel > 1e-3);
+  CHECK(worstUnits <= 1);
+}
+
+// Beyond the flat limit geo::distance() switches to a float haversine; it
+// only has to stay within a metre or so there (drive-to-course range).
+static void longRange() {
+  Rng rng(23);
+  double worstRel = 0;
+  for (int i = 0; i < 100'000; ++i) {
+    Geo a = geo::fromDegrees(rng.uniform(-70, 70), rng.uniform(-180, 180));
+    double km = 12.0 + rng.uniform(0, 200.0), t = rng.uniform(0, 2 * M_PI);
+    double dLat = km / 111.2 * cos(t);
+    double dLon = km / 111.2 * sin(t) / cos(geo::toDegrees(a.lat) * RAD);
+    double lon = geo::toDegrees(a.lon) + dLon;
+    if (lon > 180) lon -= 360;
+    if (lon < -180) lon += 360;
+    Geo b = geo::fromDegrees(geo::toDegrees(a.lat) + dLat, lon);
+    double h = haversine(a, b);
+    worstRel = fmax(worstRel, fabs(geo::distance(a, b) - h) / h);
+  }
+  printf("geo::distance() 12-212 km vs haversine: worst %.1e relative\n",
+         worstRel);
+  CHECK(worstRel < 1e-5);
+}
+
+static void benchmark() {
+  Geo origin = geo::fromDegrees(-25.9004, 28.2019);
+  geo::LocalFrame wgs(origin, geo::Earth::Wgs84);
+  Rng rng(29);
+  std::vector<Pair> ps = pairs(origin, 4096, rng);
+  std::vector<geo::Vec2> va, vb;
+  for (const Pair& p : ps) {
+    va.push_back(wgs.toLocal(p.a));
+    vb.push_back(wgs.toLocal(p.b));
+  }
+  const size_t N = 2'000'000, M = ps.size() - 1;
+  double acc = 0;
+  double frameVec = nsPer(N, [&](size_t i) { acc += wgs.distance(va[i & M], vb[i & M]); });
+  double frameGeo = nsPer(N, [&](size_t i) { acc += wgs.distance(ps[i & M].a, ps[i & M].b); });
+  double route    = nsPer(N, [&](size_t i) { acc += geo::distance(ps[i & M].a, ps[i & M].b); });
+  double hav      = nsPer(N, [&](size_t i) { acc += haversine(ps[i & M].a, ps[i & M].b); });
+  double vin      = nsPer(N / 10, [&](size_t i) { acc += vincenty(ps[i & M].a, ps[i & M].b); });
+  keep(acc);
+  printf("ns per distance: LocalFrame Vec2 %.1f, LocalFrame Geo %.1f, "
+         "geo::distance %.1f, double haversine %.1f, Vincenty %.1f\n",
+         frameVec, frameGeo, route, hav, vin);
+}
+
+int main(int, char** argv) {
+  frames();
+  longRange();
+  benchmark();
+  return checkSummary(argv[0]);
+}
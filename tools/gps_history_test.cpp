@@ -0,0 +1,204 @@
+// gps_history_test.cpp — GpsHistory's O(1) window queries against a
+// brute-force recomputation over the same fixes, then insert and query
+// cost over a 5-hour round at 10 Hz.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o gps_history_test gps_history_test.cpp ../GpsHistory.cpp ../Geo.cpp
+//
+// The track walks, stands, jitters, drops out for a few seconds now and
+// then, and starts just short of the 49-day millis() wrap so the window
+// arithmetic crosses it.  Exits non-zero if any check fails.
+#include "GpsHistory.h"
+#include "host_check.h"
+
+#include <cmath>
+#include <deque>
+#include <utility>
+#include <vector>
+
+struct Fix {
+  uint32_t ms;
+  Geo      pos;
+  uint32_t walkedMm;
+};
+
+// The same questions answered the slow way: scan every fix the ring can
+// still hold.
+class Reference {
+public:
+  void insert(uint32_t ms, const Geo& pos) {
+    if (!anchored_) {
+      anchor_ = pos;
+      anchored_ = true;
+    } else {
+      float step = geo::distance(anchor_, pos);
+      if (step >= GpsHistory::MIN_STEP_M) {
+        totalMm_ += uint32_t(step * 1000.0f);
+        anchor_ = pos;
+      }
+    }
+    fixes_.push_back(Fix{ ms, pos, totalMm_ });
+    if (fixes_.size() > GpsHistory::CAPACITY) fixes_.pop_front();
+  }
+
+  // oldest fix inside a window of `ms`: everything no older than that
+  // before the newest, and the newest itself
+  size_t first(uint32_t ms) const {
+    size_t i = fixes_.size() - 1;
+    while (i > 0 && fixes_.back().ms - fixes_[i - 1].ms <= ms) --i;
+    return i;
+  }
+
+  size_t samples(uint32_t ms) const { return fixes_.size() - first(ms); }
+
+  Geo mean(uint32_t ms) const {
+    int64_t lat = 0, lon = 0;
+    size_t n = 0;
+    for (size_t i = first(ms); i < fixes_.size(); ++i, ++n) {
+      lat += fixes_[i].pos.lat;
+      lon += fixes_[i].pos.lon;
+    }
+    return Geo{ int32_t(lat / int64_t(n)), int32_t(lon / int64_t(n)) };
+  }
+
+  float walked(uint32_t ms) const {
+    return (fixes_.back().walkedMm - fixes_[first(ms)].walkedMm) * 1e-3f;
+  }
+
+  float speed(uint32_t ms) const {
+    const Fix& a = fixes_[first(ms)];
+    const Fix& b = fixes_.back();
+    uint32_t dt = b.ms - a.ms;
+    return dt ? geo::distance(a.pos, b.pos) * 1000.0f / dt : 0.0f;
+  }
+
+  float total() const { return totalMm_ * 1e-3f; }
+
+private:
+  std::deque<Fix> fixes_;
+  Geo      anchor_;
+  bool     anchored_ = false;
+  uint32_t totalMm_  = 0;
+};
+
+// A round: walk a leg, stand over a shot, sometimes lose the fix.
+class Track {
+public:
+  explicit Track(uint32_t startMs) : ms_(startMs) {}
+
+  void next(uint32_t& ms, Geo& pos) {
+    if (!left_) {
+      walking_ = !walking_;
+      left_ = walking_ ? 300 + rng_.next() % 900 : 50 + rng_.next() % 400;
+      heading_ = rng_.uniform(0, 2 * M_PI);
+    }
+    --left_;
+    if (walking_) {
+      x_ += 0.13 * sin(heading_);           // 1.3 m/s at 10 Hz
+      y_ += 0.13 * cos(heading_);
+    }
+    ms_ += 90 + rng_.next() % 21;           // receiver jitter
+    if (rng_.next() % 2000 == 0) ms_ += 3000 + rng_.next() % 5000;   // dropout
+    // fix noise, mostly inside the jitter radius
+    double e = x_ + rng_.normal(0.6), n = y_ + rng_.normal(0.6);
+    pos = geo::fromDegrees(LAT + n / M_PER_DEG,
+                           LON + e / (M_PER_DEG * cos(LAT * M_PI / 180)));
+    ms = ms_;
+  }
+
+private:
+  static constexpr double LAT = -25.9004, LON = 28.2019, M_PER_DEG = 111'320.0;
+
+  Rng      rng_{ 11 };
+  uint32_t ms_;
+  double   x_ = 0, y_ = 0, heading_ = 0;
+  bool     walking_ = false;
+  uint32_t left_ = 0;
+};
+
+static const uint32_t WINDOWS[] = { 1'000, 5'000, 30'000, 120'000 };
+
+static void accuracy() {
+  GpsHistory h;
+  Reference  ref;
+  int ids[4];
+  for (int i = 0; i < 4; ++i) ids[i] = h.addWindow(WINDOWS[i]);
+  CHECK(h.addWindow(1) == -1);                // all four slots taken
+
+  Track track(0xFFFFFFFFu - 600'000);         // wraps ten minutes in
+  size_t checked = 0;
+  float worstWalk = 0, worstSpeed = 0;
+  for (int k = 0; k < 36'000; ++k) {          // an hour at 10 Hz
+    uint32_t ms;
+    Geo pos;
+    track.next(ms, pos);
+    h.insert(ms, pos);
+    ref.insert(ms, pos);
+
+    for (int i = 0; i < 4; ++i) {
+      size_t n = ref.samples(WINDOWS[i]);
+      Geo hm = h.mean(ids[i]), rm = ref.mean(WINDOWS[i]);
+      CHECK(h.samples(ids[i]) == n);
+      CHECK(hm.lat == rm.lat && hm.lon == rm.lon);
+      float dw = fabsf(h.walked(ids[i]) - ref.walked(WINDOWS[i]));
+      float ds = fabsf(h.speed(ids[i]) - ref.speed(WINDOWS[i]));
+      worstWalk  = fmaxf(worstWalk, dw);
+      worstSpeed = fmaxf(worstSpeed, ds);
+      ++checked;
+    }
+    CHECK(h.size() == (k + 1 < int(GpsHistory::CAPACITY) ? size_t(k + 1)
+                                                         : GpsHistory::CAPACITY));
+  }
+  CHECK(worstWalk == 0.0f);                   // same sums, same order
+  CHECK(worstSpeed < 1e-5f);
+  CHECK_NEAR(h.totalWalked(), ref.total(), 1e-3);
+  printf("%zu window queries against brute force: worst walked diff %.1e m, "
+         "speed diff %.1e m/s; %.0f m walked in the hour\n",
+         checked, worstWalk, worstSpeed, h.totalWalked());
+
+  // the longest window is capped at what the ring holds
+  CHECK(h.samples(ids[3]) == GpsHistory::CAPACITY);
+
+  // clear() empties the ring but keeps the windows
+  h.clear();
+  CHECK(h.size() == 0 && h.samples(ids[0]) == 0 && h.totalWalked() == 0.0f);
+  h.insert(5, geo::fromDegrees(-25.9, 28.2));
+  CHECK(h.samples(ids[0]) == 1 && h.speed(ids[0]) == 0.0f);
+}
+
+static void benchmark() {
+  GpsHistory h;
+  int ids[4];
+  for (int i = 0; i < 4; ++i) ids[i] = h.addWindow(WINDOWS[i]);
+
+  // 5 hours at 10 Hz, generated up front so only GpsHistory is timed
+  static constexpr size_t N = 5 * 3600 * 10;
+  std::vector<std::pair<uint32_t, Geo>> fixes;
+  Track track(0);
+  for (size_t i = 0; i < N; ++i) {
+    uint32_t ms;
+    Geo pos;
+    track.next(ms, pos);
+    fixes.emplace_back(ms, pos);
+  }
+
+  double insertNs = nsPer(N, [&](size_t i) {
+    h.insert(fixes[i].first, fixes[i].second);
+  });
+  float acc = 0;
+  double queryNs = nsPer(N, [&](size_t i) {
+    int w = ids[i & 3];
+    Geo m = h.mean(w);
+    acc += h.walked(w) + h.speed(w) + float(m.lat & 1);
+  });
+  keep(acc);
+  printf("5 h at 10 Hz (%zu fixes, %zu B of state): insert %.1f ns, "
+         "mean + walked + speed %.1f ns\n",
+         N, sizeof(GpsHistory), insertNs, queryNs);
+}
+
+int main(int, char** argv) {
+  accuracy();
+  benchmark();
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,105 @@
+// green_outline_test.cpp — GreenOutline::edges() on shapes with a known
+// answer, including the line of sight grazing a vertex or running along an
+// edge, then its cost against the outline's vertex count.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o green_outline_test green_outline_test.cpp ../GreenOutline.cpp ../Geo.cpp
+//
+// Exits non-zero if any check fails.
+#include "GreenOutline.h"
+#include "host_check.h"
+
+#include <cmath>
+#include <initializer_list>
+
+// At the equator the frame's slopes are zero, so local offsets are exact
+// metres and every expected distance below is plain geometry.
+static const geo::LocalFrame FRAME(Geo{ 0, 0 });
+
+static GreenOutline outline(std::initializer_list<geo::Vec2> pts) {
+  GreenOutline g;
+  for (const geo::Vec2& p : pts) g.add(p);
+  return g;
+}
+
+static GreenOutline circle(size_t n, float cx, float cy, float r) {
+  GreenOutline g;
+  for (size_t i = 0; i < n; ++i) {
+    double a = 2 * M_PI * double(i) / double(n);
+    g.add(geo::Vec2{ float(cx + r * cos(a)), float(cy + r * sin(a)) });
+  }
+  return g;
+}
+
+int main(int, char** argv) {
+  float front = -1, back = -1;
+  const geo::Vec2 tee{ 0, 0 }, pin{ 0, 100 };
+
+  // square green 90..110 m out, approached head on
+  GreenOutline square = outline({ { -10, 90 }, { 10, 90 }, { 10, 110 }, { -10, 110 } });
+  CHECK(square.edges(tee, pin, FRAME, front, back));
+  CHECK_NEAR(front, 90, 1e-3);
+  CHECK_NEAR(back, 110, 1e-3);
+
+  // standing on it: front is 0, back is still the far edge
+  CHECK(square.edges(geo::Vec2{ 0, 95 }, pin, FRAME, front, back));
+  CHECK_NEAR(front, 0, 1e-6);
+  CHECK_NEAR(back, 15, 1e-3);
+
+  // walked past it: the green is behind, nothing ahead
+  CHECK(!square.edges(geo::Vec2{ 0, 150 }, geo::Vec2{ 0, 200 }, FRAME, front, back));
+
+  // line wide of the green
+  CHECK(!square.edges(geo::Vec2{ 50, 0 }, geo::Vec2{ 50, 100 }, FRAME, front, back));
+
+  // the line only touches a vertex: a miss, not "on the green"
+  GreenOutline diamond = outline({ { 0, 100 }, { 10, 90 }, { 20, 100 }, { 10, 110 } });
+  CHECK(!diamond.edges(tee, geo::Vec2{ 0, 200 }, FRAME, front, back));
+
+  // the line runs along an edge without entering: also a miss
+  GreenOutline beside = outline({ { 0, 90 }, { 20, 90 }, { 20, 110 }, { 0, 110 } });
+  CHECK(!beside.edges(tee, geo::Vec2{ 0, 200 }, FRAME, front, back));
+
+  // the line passes through two opposite vertices: one crossing at each
+  GreenOutline through = outline({ { 0, 90 }, { 10, 100 }, { 0, 110 }, { -10, 100 } });
+  CHECK(through.edges(tee, pin, FRAME, front, back));
+  CHECK_NEAR(front, 90, 1e-3);
+  CHECK_NEAR(back, 110, 1e-3);
+
+  // concave (a U opening away from the tee): in, out, in, out; front is the
+  // first edge, back the last
+  GreenOutline u = outline({ { -20, 90 }, { 20, 90 }, { 20, 130 }, { 10, 130 },
+                             { 10, 100 }, { -10, 100 }, { -10, 130 }, { -20, 130 } });
+  CHECK(u.edges(geo::Vec2{ 15, 0 }, geo::Vec2{ 15, 100 }, FRAME, front, back));
+  CHECK_NEAR(front, 90, 1e-3);
+  CHECK_NEAR(back, 130, 1e-3);
+
+  // a round green from an angle: the chord through its centre
+  GreenOutline round = circle(GreenOutline::MAX_POINTS, 30, 40, 15);
+  CHECK(round.edges(tee, geo::Vec2{ 30, 40 }, FRAME, front, back));
+  CHECK_NEAR(front, 35, 0.05);
+  CHECK_NEAR(back, 65, 0.05);
+
+  // winding does not matter
+  GreenOutline cw = outline({ { -10, 110 }, { 10, 110 }, { 10, 90 }, { -10, 90 } });
+  CHECK(cw.edges(tee, pin, FRAME, front, back));
+  CHECK_NEAR(front, 90, 1e-3);
+  CHECK_NEAR(back, 110, 1e-3);
+
+  // fewer than three vertices, or more than fit
+  CHECK(!outline({ { 0, 90 }, { 0, 110 } }).edges(tee, pin, FRAME, front, back));
+  GreenOutline full = circle(GreenOutline::MAX_POINTS, 0, 100, 10);
+  CHECK(!full.add(geo::Vec2{ 0, 0 }));
+  CHECK(full.size() == GreenOutline::MAX_POINTS);
+
+  for (size_t n : { 8, 16, 32, 64 }) {
+    GreenOutline g = circle(n, 0, 100, 15);
+    double ns = nsPer(1'000'000, [&](size_t i) {
+      g.edges(geo::Vec2{ float(i % 7), 0 }, pin, FRAME, front, back);
+      keep(front);
+    });
+    printf("%2zu vertices: %6.1f ns per edges()\n", n, ns);
+  }
+
+  return checkSummary(argv[0]);
+}
@@ -0,0 +1,404 @@
+// hole_track_test.cpp — HoleIndex::locate() against a scan of every hole,
+// HoleTracker over rounds replayed through the NMEA parser, and what a
+// lookup costs on a 36-hole facility.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o hole_track_test hole_track_test.cpp ../HoleIndex.cpp ../CourseImage.cpp ../CourseIndex.cpp ../NmeaParser.cpp ../EpochAssembler.cpp ../Geo.cpp
+//
+//   hole_track_test [capture.cap ...]
+//
+// The rounds are walked over the courses built into the firmware
+// (courses_db.h) at 10 Hz: tee to pin on each hole, two to three minutes
+// moving about the green, on to the next tee, with drifting fix noise,
+// written as a capture (tools/nmea_replay's format) and read back through
+// NmeaParser and EpochAssembler the way the device sees them.  Each hole
+// has to be confirmed in turn and held from three quarters of the way
+// down it until the player leaves its green, with no flip to a hole and
+// back; detours where fairways overlap are printed.  A course whose holes all share one pin
+// (placeholder data) is skipped.
+// Field captures given on the command line are replayed against the
+// built-in course nearest their first fix and their hole changes printed.
+// Exits non-zero if any check fails.
+#include "CourseImage.h"
+#include "EpochAssembler.h"
+#include "HoleIndex.h"
+#include "NmeaParser.h"
+#include "courses_db.h"
+#include "host_check.h"
+#include "nmea_synth.h"
+
+#include <cmath>
+#include <vector>
+
+// —— Reference ——
+
+struct Segment {
+  geo::Vec2 a, b;
+};
+
+// As the device reads the receiver.
+static constexpr uint32_t FIX_HZ = 10;
+
+// locate() the slow way: every hole, same distance, same tie-break and
+// the same margin for the current hole and the next
+static int scan(const std::vector<Segment>& segs, const geo::Vec2& p,
+                int current = -1) {
+  const float limit2 = HoleIndex::HALF_WIDTH * HoleIndex::HALF_WIDTH;
+  int   best  = -1;
+  float best2 = limit2, cur2 = -1.0f, next2 = -1.0f;
+  for (size_t h = 0; h < segs.size(); ++h) {
+    const Segment& s = segs[h];
+    float vx = s.b.x - s.a.x, vy = s.b.y - s.a.y;
+    float wx = p.x - s.a.x,   wy = p.y - s.a.y;
+    float len2 = vx * vx + vy * vy;
+    float t = len2 > 0.0f ? (wx * vx + wy * vy) / len2 : 0.0f;
+    t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+    float dx = wx - t * vx, dy = wy - t * vy;
+    float d2 = dx * dx + dy * dy;
+    if (int(h) == current) cur2 = d2;
+    if (int(h) == current + 1 && current >= 0) next2 = d2;
+    if (d2 < best2) {
+      best2 = d2;
+      best  = int(h);
+    }
+  }
+  if (best < 0) return -1;
+  if (cur2 >= 0.0f && cur2 < limit2 &&
+      sqrtf(cur2) - sqrtf(best2) < HoleIndex::SWITCH_MARGIN)
+    return current;
+  if (next2 >= 0.0f && next2 < limit2 &&
+      sqrtf(next2) - sqrtf(best2) < HoleIndex::SWITCH_MARGIN)
+    return current + 1;
+  return best;
+}
+
+// A 36-hole facility: four loops of nine, fairways 120-560 m, doglegs and
+// crossings included, over about 3 x 2.5 km.
+static std::vector<Segment> facility(Rng& rng, size_t holes = 36) {
+  std::vector<Segment> out;
+  geo::Vec2 at{ 0, 0 };
+  for (size_t h = 0; h < holes; ++h) {
+    if (h % 9 == 0) at = geo::Vec2{ float(-1200.0 + 800.0 * double(h / 9 % 4)), 0 };
+    double len = rng.uniform(120, 560), dir = rng.uniform(0, 2 * M_PI);
+    geo::Vec2 pin{ float(at.x + len * sin(dir)), float(at.y + len * cos(dir)) };
+    pin.x = fmaxf(-1500, fminf(1500, pin.x));
+    pin.y = fmaxf(-1250, fminf(1250, pin.y));
+    out.push_back(Segment{ at, pin });
+    at = geo::Vec2{ pin.x + float(rng.uniform(-30, 30)), pin.y + float(rng.uniform(-30, 30)) };
+  }
+  return out;
+}
+
+static void equivalence() {
+  Rng rng(41);
+  size_t checked = 0, onHole = 0;
+  for (size_t holes : { 1, 9, 18, 36, 64, 70 }) {
+    for (int layout = 0; layout < 20; ++layout) {
+      std::vector<Segment> segs = facility(rng, holes);
+      HoleIndex ix;
+      for (const Segment& s : segs) ix.add(s.a, s.b);
+      ix.build();
+      if (holes > HoleIndex::MAX_HOLES) segs.resize(HoleIndex::MAX_HOLES);
+      CHECK(ix.size() == segs.size());
+
+      for (int i = 0; i < 20'000; ++i) {
+        geo::Vec2 p;
+        if (i & 1) {
+          // near a line, where the holes are
+          const Segment& s = segs[rng.next() % segs.size()];
+          double t = rng.uniform(-0.1, 1.1);
+          p = geo::Vec2{ float(s.a.x + t * (s.b.x - s.a.x) + rng.normal(30)),
+                         float(s.a.y + t * (s.b.y - s.a.y) + rng.normal(30)) };
+        } else {
+          p = geo::Vec2{ float(rng.uniform(-1700, 1700)), float(rng.uniform(-1500, 1500)) };
+        }
+        int want = scan(segs, p);
+        CHECK(ix.locate(p) == want);
+        // and holding on to a hole, the one found or any other
+        int current = i % 3 ? want : int(rng.next() % segs.size());
+        CHECK(ix.locate(p, current) == scan(segs, p, current));
+        onHole += want >= 0;
+        ++checked;
+      }
+    }
+  }
+  printf("locate() matches a scan of every hole at %zu points (%zu on a hole), "
+         "1 to 70 holes\n", checked, onHole);
+
+  HoleIndex empty;
+  empty.build();
+  CHECK(empty.locate(geo::Vec2{ 0, 0 }) == -1);
+
+  // hole 1 tees off at hole 0's pin: on that green hole 0 holds until the
+  // player is SWITCH_MARGIN nearer hole 1's line
+  HoleIndex two;
+  two.add(geo::Vec2{ 0, -300 }, geo::Vec2{ 0, 0 });
+  two.add(geo::Vec2{ 0, 0 }, geo::Vec2{ 300, 0 });
+  two.build();
+  CHECK(two.locate(geo::Vec2{ 0, 0 }) == 0);      // a tie goes to the lower
+  CHECK(two.locate(geo::Vec2{ 0, 0 }, 1) == 1);
+  CHECK(two.locate(geo::Vec2{ 15, 0 }) == 1);
+  CHECK(two.locate(geo::Vec2{ 15, 0 }, 0) == 0);
+  CHECK(two.locate(geo::Vec2{ 25, 0 }, 0) == 1);
+  CHECK(two.locate(geo::Vec2{ 0, -15 }, 1) == 1);
+  CHECK(two.locate(geo::Vec2{ 0, -25 }, 1) == 0);
+}
+
+static void tracker() {
+  HoleTracker t;
+  CHECK(t.current() == -1);
+  CHECK(t.confirmFixes() == 3);   // 1 Hz until told otherwise
+  t.setRate(FIX_HZ);
+  const int n = t.confirmFixes();
+  CHECK(n == int(HoleTracker::CONFIRM_S * FIX_HZ));
+  for (int i = 0; i < n - 1; ++i) CHECK(!t.update(3));
+  CHECK(t.update(3) && t.current() == 3);
+
+  // one fix elsewhere, or a run cut short, changes nothing
+  CHECK(!t.update(4));
+  CHECK(!t.update(3));
+  for (int i = 0; i < n - 1; ++i) CHECK(!t.update(4));
+  CHECK(!t.update(5));
+  CHECK(t.current() == 3);
+
+  // off every hole keeps the current one and breaks a run
+  for (int i = 0; i < n - 1; ++i) CHECK(!t.update(4));
+  CHECK(!t.update(-1));
+  CHECK(!t.update(4));
+  CHECK(t.current() == 3);
+
+  // a tee counts for most of the window; the fixes after it finish it
+  const int rest = n - int(HoleTracker::TEE_VOTE_S * FIX_HZ);
+  t.reset(3);
+  CHECK(!t.teeEntered(4));
+  for (int i = 0; i < rest - 1; ++i) CHECK(!t.update(4));
+  CHECK(t.update(4) && t.current() == 4);
+  // but not over the lookups: one for the current hole undoes it
+  CHECK(!t.teeEntered(5));
+  CHECK(!t.update(4));
+  for (int i = 0; i < rest; ++i) CHECK(!t.update(5));
+  CHECK(t.current() == 4);
+  // nor a tee of the current hole
+  CHECK(!t.teeEntered(4) && t.current() == 4);
+
+  t.reset(7);
+  CHECK(t.current() == 7 && !t.update(7));
+  t.setRate(0);
+  CHECK(t.confirmFixes() == 3);
+}
+
+// —— Rounds ——
+
+struct Played {
+  std::vector<int> changes;   // confirmed holes, in order
+  std::vector<int> current;   // confirmed hole after each fix
+  size_t offHole = 0;
+};
+
+// Feed a capture through the parser and a HolePage's lookup for `course`.
+static Played play(const std::vector<uint8_t>& cap, const Course& course) {
+  HoleIndex ix;
+  for (const Hole& h : course.holes)
+    ix.add(course.frame.toLocal(h.tee), course.frame.toLocal(h.pin));
+  ix.build();
+
+  Played out;
+  HoleTracker t;
+  t.setRate(FIX_HZ);
+  NmeaParser parser;
+  EpochAssembler epoch;
+  synth::forEachRecord(cap, [&](uint32_t, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      if (!epoch.add(parser, parser.feed(char(p[i])))) continue;
+      const GpsData& d = epoch.latest();
+      if (!d.fix) continue;
+      int hole = ix.locate(course.frame.toLocal(d.pos), t.current());
+      out.offHole += hole < 0;
+      if (t.update(hole)) out.changes.push_back(t.current());
+      out.current.push_back(t.current());
+    }
+  });
+  return out;
+}
+
+struct Round {
+  std::vector<uint8_t> capture;
+  std::vector<size_t>  onHole;    // fix index 3/4 of the way down each hole
+  std::vector<size_t>  offGreen;  // first fix after leaving each green
+  size_t               fixes = 0;
+};
+
+// Walk `course` at 1.3 m/s with FIX_HZ fixes, then spend two to three
+// minutes on each green: walking to spots up to 12 m from the pin at
+// 0.5 m/s and standing at each for 5-30 s.  Fix error drifts, with
+// `noise` m spread per axis and a 5 s time constant, as a receiver's does.
+static Round walk(const Course& course, double noise, Rng& rng) {
+  const uint32_t stepMs = 1000 / FIX_HZ;
+  const double drift = exp(-1.0 / (5.0 * FIX_HZ));
+  synth::CaptureWriter cap;
+  Round out;
+  GpsData d;
+  d.fix = true;
+  d.fixQuality = 1;
+  d.sats = 9;
+  d.hdop = 1.1f;
+  d.hour = 7;
+  d.day = 17;
+  d.month = 10;
+  d.year = 2026;
+  double ex = 0, ey = 0;
+  size_t& fixes = out.fixes;
+  auto fix = [&](const geo::Vec2& p) {
+    ex = drift * ex + sqrt(1 - drift * drift) * rng.normal(noise);
+    ey = drift * ey + sqrt(1 - drift * drift) * rng.normal(noise);
+    d.pos = course.frame.toGeo(geo::Vec2{ p.x + float(ex), p.y + float(ey) });
+    cap.add(uint32_t(uint64_t(fixes) * stepMs * 1000), synth::epoch(d));
+    synth::tick(d, stepMs);
+    ++fixes;
+  };
+  auto leg = [&](const geo::Vec2& a, const geo::Vec2& b, float speed) {
+    int steps = int(geo::distance(a, b) / speed * FIX_HZ) + 1;
+    for (int s = 1; s <= steps; ++s) {
+      float f = float(s) / steps;
+      fix(geo::Vec2{ a.x + f * (b.x - a.x), a.y + f * (b.y - a.y) });
+    }
+  };
+  for (size_t h = 0; h < course.holes.size(); ++h) {
+    geo::Vec2 tee = course.frame.toLocal(course.holes[h].tee);
+    geo::Vec2 pin = course.frame.toLocal(course.holes[h].pin);
+    size_t start = fixes;
+    leg(tee, pin, 1.3f);
+    // a hole teeing off back along the last one only wins once clear of it
+    out.onHole.push_back(start + (fixes - start) * 3 / 4);
+
+    size_t leave = fixes + size_t(rng.uniform(120, 180) * FIX_HZ);
+    geo::Vec2 at = pin;
+    while (fixes < leave) {
+      double r = 12.0 * sqrt(rng.uniform()), a = rng.uniform(0, 2 * M_PI);
+      geo::Vec2 spot{ pin.x + float(r * sin(a)), pin.y + float(r * cos(a)) };
+      leg(at, spot, 0.5f);
+      for (int s = int(rng.uniform(5, 30) * FIX_HZ); s > 0; --s) fix(spot);
+      at = spot;
+    }
+    leg(at, pin, 0.5f);
+    out.offGreen.push_back(fixes);
+    if (h + 1 < course.holes.size())
+      leg(pin, course.frame.toLocal(course.holes[h + 1].tee), 1.3f);
+  }
+  out.capture = cap.bytes();
+  return out;
+}
+
+static void rounds(CourseImage& image, Arena& arena) {
+  Rng rng(43);
+  for (size_t c = 0; c < image.size(); ++c) {
+    Course course;
+    CHECK(image.decode(c, course, arena));
+    bool placeholder = false;
+    for (size_t h = 1; h < course.holes.size(); ++h)
+      placeholder |= course.holes[h].pin.lat == course.holes[0].pin.lat &&
+                     course.holes[h].pin.lon == course.holes[0].pin.lon;
+    if (placeholder) {
+      printf("%-10s skipped: its holes share one pin\n", image.name(c));
+      continue;
+    }
+
+    for (double noise : { 0.0, 3.0, 8.0 }) {
+      Round r = walk(course, noise, rng);
+      Played p = play(r.capture, course);
+      CHECK(p.current.size() == r.fixes);
+      if (p.current.size() != r.fixes) continue;
+
+      // every hole confirmed in turn, and held from most of the way down it
+      // until the player leaves its green
+      size_t next = 0, early = 0, flips = 0;
+      for (int h : p.changes)
+        if (next < course.holes.size() && h == int(next)) ++next;
+      for (size_t h = 0; h < r.onHole.size(); ++h)
+        for (size_t i = r.onHole[h]; i < r.offGreen[h]; ++i)
+          early += p.current[i] != int(h);
+      // and never off to a hole and straight back
+      for (size_t i = 2; i < p.changes.size(); ++i)
+        flips += p.changes[i] == p.changes[i - 2];
+      printf("%-10s %zu holes, fix noise %.0f m: %zu fixes, %zu off every hole, "
+             "%zu hole changes:", image.name(c), course.holes.size(), noise,
+             p.current.size(), p.offHole, p.changes.size());
+      for (int h : p.changes) printf(" %d", course.holes[h].number);
+      printf("\n");
+      CHECK(next == course.holes.size());
+      CHECK(early == 0);
+      CHECK(flips == 0);
+      // on the line itself nothing else is ever confirmed
+      if (noise == 0.0) CHECK(p.changes.size() == course.holes.size());
+    }
+  }
+}
+
+static void field(const char* path, CourseImage& image, Arena& arena) {
+  std::vector<uint8_t> cap = synth::readFile(path);
+  // the course nearest the first fix
+  NmeaParser parser;
+  EpochAssembler epoch;
+  Geo first;
+  bool found = false;
+  synth::forEachRecord(cap, [&](uint32_t, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n && !found; ++i)
+      if (epoch.add(parser, parser.feed(char(p[i]))) && epoch.latest().fix) {
+        first = epoch.latest().pos;
+        found = true;
+      }
+  });
+  uint32_t c;
+  if (!found || !image.nearest(first, 1, &c)) {
+    fprintf(stderr, "%s: no fix in the capture\n", path);
+    return;
+  }
+  Course course;
+  image.decode(c, course, arena);
+  Played p = play(cap, course);
+  printf("%s on %s: %zu fixes, %zu off every hole, holes", path, image.name(c),
+         p.current.size(), p.offHole);
+  for (int h : p.changes) printf(" %d", course.holes[h].number);
+  printf("\n");
+}
+
+// —— Cost ——
+
+static void benchmark() {
+  Rng rng(47);
+  std::vector<Segment> segs = facility(rng);
+  HoleIndex ix;
+  for (const Segment& s : segs) ix.add(s.a, s.b);
+  double buildNs = nsPer(50, [&](size_t) { ix.build(); });
+
+  std::vector<geo::Vec2> pts(4096);
+  for (geo::Vec2& p : pts) {
+    const Segment& s = segs[rng.next() % segs.size()];
+    double t = rng.uniform();
+    p = geo::Vec2{ float(s.a.x + t * (s.b.x - s.a.x) + rng.normal(15)),
+                   float(s.a.y + t * (s.b.y - s.a.y) + rng.normal(15)) };
+  }
+  int acc = 0;
+  double gridNs = nsPer(4'000'000, [&](size_t i) { acc += ix.locate(pts[i & 4095]); });
+  double scanNs = nsPer(400'000, [&](size_t i) { acc += scan(segs, pts[i & 4095]); });
+  keep(acc);
+  printf("36 holes: build %.0f us, %zu B; locate %.1f ns, scanning every hole "
+         "%.1f ns\n", buildNs / 1e3, ix.bytes(), gridNs, scanNs);
+}
+
+int main(int argc, char** argv) {
+  CourseImage image;
+  CHECK(image.open(coursedb::IMAGE, sizeof(coursedb::IMAGE)));
+  Arena arena;
+  arena.reserve(image.arenaBytes());
+
+  if (argc > 1) {
+    for (int i = 1; i < argc; ++i) field(argv[i], image, arena);
+    return checkSummary(argv[0]);
+  }
+  equivalence();
+  tracker();
+  rounds(image, arena);
+  benchmark();
+  return checkSummary(argv[0]);
+}
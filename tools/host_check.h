@@ -0,0 +1,83 @@
+// host_check.h — the bits the host tests in this directory share.
+//
+// CHECK() / CHECK_NEAR() report a failure with its line and carry on, so
+// one run lists everything that is wrong; main() ends with
+// `return checkSummary(argv[0]);`, which exits non-zero on any failure.
+// nsPer() times a loop for the benchmark lines the tests print too, and
+// Rng makes the same "random" inputs on every run.
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+static int checkFailures = 0;
+
+#define CHECK(cond)                                                         \
+  do {                                                                      \
+    if (!(cond)) {                                                          \
+      ++checkFailures;                                                      \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,      \
+              #cond);                                                       \
+    }                                                                       \
+  } while (0)
+
+#define CHECK_NEAR(a, b, tol)                                               \
+  do {                                                                      \
+    double a_ = (a), b_ = (b);                                              \
+    if (!(std::fabs(a_ - b_) <= (tol))) {                                   \
+      ++checkFailures;                                                      \
+      fprintf(stderr, "%s:%d: %s = %.9g, %s = %.9g, tolerance %g\n",        \
+              __FILE__, __LINE__, #a, a_, #b, b_, double(tol));             \
+    }                                                                       \
+  } while (0)
+
+inline int checkSummary(const char* name) {
+  if (checkFailures)
+    fprintf(stderr, "%s: %d check(s) FAILED\n", name, checkFailures);
+  else
+    fprintf(stderr, "%s: all checks passed\n", name);
+  return checkFailures ? 1 : 0;
+}
+
+/// Keep a result alive so the optimiser cannot drop the loop making it.
+template <typename T>
+inline void keep(const T& v) {
+  asm volatile("" : : "r"(&v) : "memory");
+}
+
+/// Mean nanoseconds per call of f(i) over n calls.
+template <typename F>
+double nsPer(size_t n, F&& f) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; ++i) f(i);
+  std::chrono::duration<double, std::nano> dt =
+    std::chrono::steady_clock::now() - t0;
+  return dt.count() / double(n);
+}
+
+/// xorshift64*: small, fast and the same sequence everywhere.
+struct Rng {
+  uint64_t s;
+  explicit Rng(uint64_t seed = 0x9E3779B97F4A7C15ull) : s(seed ? seed : 1) {}
+
+  uint32_t next() {
+    s ^= s >> 12;
+    s ^= s << 25;
+    s ^= s >> 27;
+    return uint32_t((s * 0x2545F4914F6CDD1Dull) >> 32);
+  }
+
+  /// Uniform in [lo, hi).
+  double uniform(double lo = 0.0, double hi = 1.0) {
+    return lo + (hi - lo) * (next() / 4294967296.0);
+  }
+
+  /// Roughly normal, mean 0 and deviation `sd` (sum of four uniforms).
+  double normal(double sd = 1.0) {
+    double u = uniform() + uniform() + uniform() + uniform() - 2.0;
+    return u * sd * 1.7320508;   // the sum's deviation is 1/sqrt(3)
+  }
+};
@@ -0,0 +1,227 @@
+// motion_gate_test.cpp — MotionGate and StickyValue against reference
+// implementations written straight from their contracts, their behaviour
+// over a simulated round, and what the gate saves HolePage per fix.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o motion_gate_test motion_gate_test.cpp ../TargetTable.cpp ../Geo.cpp
+//
+// The round is four hours at 10 Hz: walks at 1.3 m/s, waits over the ball
+// and on the tee, HDOP drifting between 0.7 and 4, fix jitter to match.
+// Exits non-zero if any check fails.
+#include "MotionGate.h"
+#include "TargetTable.h"
+#include "host_check.h"
+
+#include <cmath>
+#include <vector>
+
+// —— References ——
+
+// MotionGate as documented: a fix passes when nothing has passed since
+// reset, or it lies at least clamp(hdop, 0.5, 5) m from the last one that
+// passed.  Distances in double: the gate's float compare has to agree.
+class RefGate {
+public:
+  bool pass(const geo::Vec2& p, float hdop) {
+    double t = fmin(fmax(double(hdop) * MotionGate::M_PER_HDOP, MotionGate::MIN_M),
+                    MotionGate::MAX_M);
+    if (armed_ && hypot(double(p.x) - a_.x, double(p.y) - a_.y) < t) return false;
+    a_ = p;
+    armed_ = true;
+    return true;
+  }
+  void reset() { armed_ = false; }
+
+private:
+  geo::Vec2 a_;
+  bool armed_ = false;
+};
+
+// StickyValue as documented: follow the reading once it is a band or more
+// from what is shown.
+class RefSticky {
+public:
+  bool update(double v, double band) {
+    if (valid_ && fabs(v - shown_) < band) return false;
+    shown_ = v;
+    valid_ = true;
+    return true;
+  }
+  void reset() { valid_ = false; }
+
+private:
+  double shown_ = 0;
+  bool valid_ = false;
+};
+
+// —— The round ——
+
+struct Fix {
+  geo::Vec2 pos;
+  float     hdop;
+};
+
+static std::vector<Fix> round(size_t n, Rng& rng) {
+  std::vector<Fix> out;
+  double x = 0, y = 0, heading = 0, hdop = 1.0;
+  bool walking = false;
+  uint32_t left = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (!left) {
+      walking = !walking;
+      left = walking ? 300 + rng.next() % 1500 : 200 + rng.next() % 1800;
+      heading = rng.uniform(0, 2 * M_PI);
+    }
+    --left;
+    if (walking) {
+      x += 0.13 * sin(heading);
+      y += 0.13 * cos(heading);
+    }
+    hdop = fmin(4.0, fmax(0.7, hdop + rng.normal(0.02)));
+    // consecutive-fix jitter grows with HDOP, about a metre per unit
+    double sd = 0.3 * hdop;
+    out.push_back(Fix{ geo::Vec2{ float(x + rng.normal(sd)), float(y + rng.normal(sd)) },
+                       float(hdop) });
+  }
+  return out;
+}
+
+// —— Checks ——
+
+static void gate(const std::vector<Fix>& fixes) {
+  MotionGate g;
+  RefGate ref;
+  size_t differ = 0;
+  geo::Vec2 anchor;
+  double worstLag = 0;
+  for (size_t i = 0; i < fixes.size(); ++i) {
+    const Fix& f = fixes[i];
+    if (i % 5000 == 0) {                 // targets changed
+      g.reset();
+      ref.reset();
+    }
+    bool a = g.pass(f.pos, f.hdop);
+    differ += a != ref.pass(f.pos, f.hdop);
+    if (a) anchor = f.pos;
+    // the last fix let through is never MAX_M from the current one
+    worstLag = fmax(worstLag, hypot(double(f.pos.x) - anchor.x,
+                                    double(f.pos.y) - anchor.y));
+  }
+  printf("MotionGate: %zu fixes, %u passed, %u skipped; %zu differ from the "
+         "reference, worst anchor lag %.2f m\n",
+         fixes.size(), g.passed(), g.skipped(), differ, worstLag);
+  CHECK(differ == 0);
+  CHECK(g.passed() + g.skipped() == fixes.size());
+  CHECK(worstLag < MotionGate::MAX_M);
+
+  // standing over the ball, the jitter is held back...
+  MotionGate still;
+  Rng rng(59);
+  for (int i = 0; i < 600; ++i)
+    still.pass(geo::Vec2{ float(rng.normal(0.3)), float(rng.normal(0.3)) }, 1.0f);
+  CHECK(still.passed() < 60);          // under one fix in ten
+
+  // ...but a slow walk still gets through, once per threshold walked
+  MotionGate slow;
+  for (int i = 0; i <= 200; ++i) slow.pass(geo::Vec2{ 0.0f, i * 0.05f }, 1.0f);
+  CHECK(slow.passed() == 11);          // 0, 1, ..., 10 m
+
+  // HDOP clamps: 0.5 m at the least, 5 m at the most
+  MotionGate lo, hi;
+  lo.pass(geo::Vec2{}, 0.1f);
+  CHECK(!lo.pass(geo::Vec2{ 0.45f, 0 }, 0.1f) && lo.pass(geo::Vec2{ 0.55f, 0 }, 0.1f));
+  hi.pass(geo::Vec2{}, 20.0f);
+  CHECK(!hi.pass(geo::Vec2{ 4.9f, 0 }, 20.0f) && hi.pass(geo::Vec2{ 5.1f, 0 }, 20.0f));
+
+  // reset() lets the very next fix through wherever it is
+  hi.reset();
+  CHECK(hi.pass(geo::Vec2{ 5.1f, 0 }, 20.0f));
+}
+
+// HolePage::DISPLAY_BAND_M; HolePage.h needs LVGL, so it is restated here
+static constexpr float BAND_M = 0.75f;
+
+static void sticky(const std::vector<Fix>& fixes) {
+  // the distance to a pin 150 m up the first fairway, shown in whole
+  // metres, for the fixes HolePage's gate lets through
+  MotionGate g;
+  StickyValue v;
+  RefSticky ref;
+  geo::Vec2 pin{ 0, 150 };
+  size_t readings = 0, differ = 0, labelChanges = 0, plainChanges = 0;
+  long label = -1, plain = -1;
+  double worst = 0;
+  for (size_t i = 0; i < fixes.size(); ++i) {
+    if (i % 5000 == 0) {
+      g.reset();
+      v.reset();
+      ref.reset();
+    }
+    if (!g.pass(fixes[i].pos, fixes[i].hdop)) continue;
+    float d = geo::distance(fixes[i].pos, pin);
+    differ += v.update(d, BAND_M) != ref.update(d, BAND_M);
+    worst = fmax(worst, fabs(d - v.value()));
+    ++readings;
+    labelChanges += lround(v.value()) != label;
+    plainChanges += lround(d) != plain;
+    label = lround(v.value());
+    plain = lround(d);
+  }
+  printf("StickyValue: %zu gated readings, label rewritten %zu times where "
+         "plain rounding would %zu; %zu differ from the reference, shown value "
+         "at most %.2f m off\n",
+         readings, labelChanges, plainChanges, differ, worst);
+  CHECK(differ == 0);
+  CHECK(worst < BAND_M);
+  CHECK(labelChanges < plainChanges);
+
+  // hovering on a rounding boundary: one change, not a flicker
+  StickyValue h;
+  Rng rng(61);
+  size_t flips = 0;
+  for (int i = 0; i < 1000; ++i) flips += h.update(float(149.5 + rng.normal(0.1)), BAND_M);
+  CHECK(flips == 1);
+}
+
+// —— Cost ——
+
+static void benchmark(const std::vector<Fix>& fixes) {
+  geo::LocalFrame frame(geo::fromDegrees(-25.9004, 28.2019), geo::Earth::Wgs84);
+  TargetTable t;
+  Rng rng(67);
+  for (int i = 0; i < 18; ++i)
+    t.add(i < 3 ? TargetKind(i) : TargetKind::Hazard,
+          geo::Vec2{ float(rng.uniform(-100, 100)), float(rng.uniform(0, 500)) });
+
+  const size_t N = fixes.size();
+  float acc = 0;
+  MotionGate g;
+  double gateNs = nsPer(N, [&](size_t i) { acc += g.pass(fixes[i].pos, fixes[i].hdop); });
+  StickyValue s;
+  double stickyNs = nsPer(N, [&](size_t i) { acc += s.update(fixes[i].pos.y, BAND_M); });
+
+  // HolePage's per-fix work, on every fix and behind the gate
+  double everyNs = nsPer(N, [&](size_t i) {
+    t.solve(fixes[i].pos, frame);
+    acc += t.distance(0);
+  });
+  MotionGate gated;
+  double gatedNs = nsPer(N, [&](size_t i) {
+    if (gated.pass(fixes[i].pos, fixes[i].hdop)) t.solve(fixes[i].pos, frame);
+    acc += t.distance(0);
+  });
+  keep(acc);
+  printf("per fix: MotionGate::pass %.1f ns, StickyValue::update %.1f ns; "
+         "18-target solve on every fix %.1f ns, behind the gate %.1f ns "
+         "(%.0f%% of fixes pass)\n",
+         gateNs, stickyNs, everyNs, gatedNs, 100.0 * gated.passed() / N);
+}
+
+int main(int, char** argv) {
+  Rng rng(71);
+  std::vector<Fix> fixes = round(4 * 3600 * 10, rng);
+  gate(fixes);
+  sticky(fixes);
+  benchmark(fixes);
+  return checkSummary(argv[0]);
+}
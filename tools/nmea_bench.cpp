@@ -0,0 +1,209 @@
+// nmea_bench.cpp — NmeaParser throughput on recorded or synthetic receiver
+// output, next to the line-buffered parse GpsManager used before it.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o nmea_bench nmea_bench.cpp ../NmeaParser.cpp ../EpochAssembler.cpp
+//
+//   nmea_bench [capture.cap ...]
+//
+// With no arguments it builds two 10-minute, 10 Hz streams, one in the
+// GGA+RMC mix the link negotiates and one in ALLDATA, with every 97th
+// epoch's RMC damaged, and checks every fix comes out and every damaged
+// sentence is counted.  Field captures (tools/nmea_replay's input) are
+// timed the same way.
+//
+// Adafruit_GPS does not build off the device, so the "line" column is a
+// stand-in for the path it replaced: read() copies each byte into a line
+// buffer, update() strncmp()s the prefix at end of line, and parse()
+// re-walks the line for the checksum and then field by field with
+// strchr / atol / atof.  Expect the device ratio to differ; the bytes/us
+// figure for NmeaParser is the one to compare across changes.
+#include "EpochAssembler.h"
+#include "NmeaParser.h"
+#include "host_check.h"
+#include "nmea_synth.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// —— The line-buffered stand-in ——
+
+class LineParser {
+public:
+  /// True when a GGA or RMC with a good checksum has been applied to `d`.
+  bool feed(char c, GpsData& d) {
+    if (c == '$') n_ = 0;
+    if (n_ < sizeof(line_) - 1) line_[n_++] = c;
+    if (c != '\n') return false;
+    line_[n_] = '\0';
+    n_ = 0;
+    if (strncmp(line_, "$GPGGA", 6) && strncmp(line_, "$GPRMC", 6)) return false;
+    return parse(d);
+  }
+
+private:
+  static double angle(const char* p) {
+    // dd(d)mm.mmmm: degrees before the last two integer digits
+    const char* dot = strchr(p, '.');
+    char deg[4] = {};
+    size_t nd = size_t(dot - p) - 2;
+    memcpy(deg, p, nd < 3 ? nd : 3);
+    return atol(deg) + atof(p + nd) / 60.0;
+  }
+
+  static const char* next(const char* p) {
+    p = strchr(p, ',');
+    return p ? p + 1 : nullptr;
+  }
+
+  bool parse(GpsData& d) {
+    const char* star = strchr(line_, '*');
+    if (!star) return false;
+    uint8_t sum = 0;
+    for (const char* p = line_ + 1; p < star; ++p) sum ^= uint8_t(*p);
+    if (strtol(star + 1, nullptr, 16) != sum) return false;
+
+    bool gga = line_[3] == 'G';
+    const char* p = next(line_);
+    long t = atol(p);
+    d.hour = uint8_t(t / 10000);
+    d.minute = uint8_t(t / 100 % 100);
+    d.second = uint8_t(t % 100);
+    d.millis = uint16_t(atof(p + 6) * 1000 + 0.5);
+    p = next(p);
+    if (!gga) {
+      d.fix = *p == 'A';
+      p = next(p);
+    }
+    double lat = angle(p);
+    p = next(p);
+    if (*p == 'S') lat = -lat;
+    p = next(p);
+    double lon = angle(p);
+    p = next(p);
+    if (*p == 'W') lon = -lon;
+    d.pos = geo::fromDegrees(lat, lon);
+    p = next(p);
+    if (gga) {
+      d.fixQuality = uint8_t(atoi(p));
+      d.sats = uint8_t(atoi(p = next(p)));
+      d.hdop = float(atof(p = next(p)));
+      d.altitude = float(atof(next(p)));
+    } else {
+      d.speedKnots = float(atof(p));
+      d.trackAngle = float(atof(p = next(p)));
+      long date = atol(next(p));
+      d.day = uint8_t(date / 10000);
+      d.month = uint8_t(date / 100 % 100);
+      d.year = uint16_t(2000 + date % 100);
+    }
+    return true;
+  }
+
+  char   line_[120];
+  size_t n_ = 0;
+};
+
+// —— Inputs ——
+
+struct Stream {
+  std::string name;
+  std::string bytes;
+  size_t epochs  = 0;    // expected, for synthetic streams
+  size_t damaged = 0;
+};
+
+static Stream synthetic(const char* name, bool alldata) {
+  Stream s;
+  s.name = name;
+  Rng rng(42);
+  GpsData d;
+  d.fix = true;
+  d.fixQuality = 1;
+  d.sats = 9;
+  d.hour = 7;
+  d.day = 17;
+  d.month = 10;
+  d.year = 2026;
+  d.pos = geo::fromDegrees(-25.9004, 28.2019);
+  for (size_t i = 0; i < 6000; ++i, synth::tick(d, 100)) {
+    d.pos.lat += int32_t(rng.normal(8));
+    d.pos.lon += int32_t(rng.normal(8));
+    d.hdop = float(0.8 + rng.uniform(0, 0.6));
+    d.speedKnots = float(rng.uniform(0, 3));
+    d.trackAngle = float(rng.uniform(0, 360));
+    std::string e = synth::epoch(d, 4, alldata);
+    if (i % 97 == 96) {
+      e[e.size() - 4] ^= 1;        // last checksum digit of the RMC
+      ++s.damaged;
+    }
+    s.bytes += e;
+    ++s.epochs;
+  }
+  return s;
+}
+
+static Stream recorded(const char* path) {
+  Stream s;
+  s.name = path;
+  if (!synth::forEachRecord(synth::readFile(path),
+                            [&](uint32_t, const uint8_t* p, size_t n) {
+                              s.bytes.append(reinterpret_cast<const char*>(p), n);
+                            }))
+    fprintf(stderr, "%s: not a whole NMEA capture\n", path);
+  return s;
+}
+
+// —— Runs ——
+
+static void run(const Stream& s) {
+  const size_t reps = s.bytes.size() < (1u << 20) ? 20 : 3;
+  NmeaParser     parser;
+  EpochAssembler epoch;
+  size_t fixes = 0;
+  double ns = nsPer(reps, [&](size_t) {
+    parser = NmeaParser{};
+    epoch = EpochAssembler{};
+    fixes = 0;
+    for (char c : s.bytes)
+      if (epoch.add(parser, parser.feed(c))) ++fixes;
+  });
+
+  LineParser line;
+  GpsData    d;
+  size_t     lineSentences = 0;
+  double lineNs = nsPer(reps, [&](size_t) {
+    line = LineParser{};
+    lineSentences = 0;
+    for (char c : s.bytes)
+      if (line.feed(c, d)) ++lineSentences;
+  });
+
+  double mb = double(s.bytes.size());
+  printf("%-28s %8zu bytes %6zu fixes %4u bad sums   NmeaParser %6.1f bytes/us"
+         "   line %5.1f bytes/us   x%.1f\n",
+         s.name.c_str(), s.bytes.size(), fixes, parser.checksumErrors(),
+         mb / (ns / 1e3), mb / (lineNs / 1e3), lineNs / ns);
+
+  if (s.epochs) {
+    // a damaged RMC leaves its GGA to be published alone at the next epoch
+    CHECK(fixes == s.epochs);
+    CHECK(parser.checksumErrors() == s.damaged);
+    CHECK(parser.truncated() == 0);
+    CHECK(lineSentences == 2 * s.epochs - s.damaged);
+    const GpsData& last = epoch.latest();
+    CHECK(last.pos.lat == d.pos.lat && last.pos.lon == d.pos.lon);
+    CHECK(last.sats == d.sats && last.hour == d.hour && last.millis == d.millis);
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    for (int i = 1; i < argc; ++i) run(recorded(argv[i]));
+  } else {
+    run(synthetic("synthetic GGA+RMC, 10 min", false));
+    run(synthetic("synthetic ALLDATA, 10 min", true));
+  }
+  return checkSummary(argv[0]);
+}
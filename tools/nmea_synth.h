@@ -0,0 +1,149 @@
+// nmea_synth.h — receiver output for the host tests when no field capture
+// is at hand: GGA/RMC text for a GpsData, formatted the way the MTK
+// receivers send it, and capture files (CaptureFormat.h) cut into the
+// reads the UART task makes.  Field captures are read back through the
+// same forEachRecord(), so a test can take either.
+#pragma once
+
+#include "CaptureFormat.h"
+#include "GpsData.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace synth {
+
+/// "$body*hh\r\n"
+inline std::string sentence(const std::string& body) {
+  uint8_t sum = 0;
+  for (char c : body) sum ^= uint8_t(c);
+  char tail[8];
+  snprintf(tail, sizeof(tail), "*%02X\r\n", sum);
+  return "$" + body + tail;
+}
+
+/// (d)ddmm.m… and hemisphere for a fixed-point angle.  Seven minute
+/// digits carry 1e-7 degrees exactly (the parser gives back the same
+/// int32); the receivers send four.
+inline std::string angle(int32_t e7, bool lon, int minuteDigits) {
+  uint64_t a = uint64_t(e7 < 0 ? -int64_t(e7) : e7);
+  uint64_t one = 1;                                   // 10^minuteDigits
+  for (int i = 0; i < minuteDigits; ++i) one *= 10;
+  // whole angle in units of the last minute digit, rounded once
+  uint64_t m = (a * 60 * one + 5'000'000) / 10'000'000;
+  char buf[32];
+  snprintf(buf, sizeof(buf), lon ? "%03u%02u.%0*llu,%c" : "%02u%02u.%0*llu,%c",
+           unsigned(m / (60 * one)), unsigned(m / one % 60), minuteDigits,
+           (unsigned long long)(m % one),
+           lon ? (e7 < 0 ? 'W' : 'E') : (e7 < 0 ? 'S' : 'N'));
+  return buf;
+}
+
+/// The GGA and RMC of one epoch.  `extras` adds the GSA and three GSV
+/// parts the ALLDATA mix carries, which the parser has to skip.
+inline std::string epoch(const GpsData& d, int minuteDigits = 4,
+                         bool extras = false) {
+  char t[16], date[16], body[128];
+  snprintf(t, sizeof(t), "%02u%02u%02u.%03u", d.hour, d.minute, d.second,
+           d.millis);
+  snprintf(date, sizeof(date), "%02u%02u%02u", d.day, d.month, d.year % 100);
+  std::string lat = angle(d.pos.lat, false, minuteDigits);
+  std::string lon = angle(d.pos.lon, true, minuteDigits);
+
+  snprintf(body, sizeof(body), "GPGGA,%s,%s,%s,%u,%02u,%.2f,%.1f,M,0.0,M,,",
+           t, lat.c_str(), lon.c_str(), d.fixQuality, d.sats, d.hdop,
+           d.altitude);
+  std::string out = sentence(body);
+  if (extras) {
+    out += sentence("GPGSA,A,3,04,05,09,12,24,25,29,31,,,,,1.8,1.0,1.5");
+    out += sentence("GPGSV,3,1,11,04,39,046,43,05,20,293,38,09,42,133,44,12,11,042,33");
+    out += sentence("GPGSV,3,2,11,24,67,242,47,25,22,307,40,29,09,181,30,31,48,083,45");
+    out += sentence("GPGSV,3,3,11,02,05,010,,14,12,220,28,26,03,330,");
+  }
+  snprintf(body, sizeof(body), "GPRMC,%s,%c,%s,%s,%.2f,%.2f,%s,,,A", t,
+           d.fix ? 'A' : 'V', lat.c_str(), lon.c_str(), d.speedKnots,
+           d.trackAngle, date);
+  out += sentence(body);
+  return out;
+}
+
+/// Builds a capture the way NmeaCapture lays one out: each burst of
+/// receiver output is cut into the ≤128-byte reads the UART task makes,
+/// timestamped as the bytes would arrive at `baud`.
+class CaptureWriter {
+public:
+  explicit CaptureWriter(uint32_t baud = 115200) : baud_(baud) {
+    bytes_.assign(capture::MAGIC, capture::MAGIC + sizeof(capture::MAGIC));
+  }
+
+  /// Output that starts arriving at `us` (micros(), so it may wrap).
+  void add(uint32_t us, const std::string& text, size_t chunk = 128) {
+    for (size_t at = 0; at < text.size(); at += chunk) {
+      size_t n = text.size() - at < chunk ? text.size() - at : chunk;
+      us += uint32_t(uint64_t(n) * 10'000'000 / baud_);   // 8N1 wire time
+      uint8_t h[capture::HEADER_LEN];
+      capture::putHeader(h, us, uint16_t(n));
+      bytes_.insert(bytes_.end(), h, h + sizeof(h));
+      bytes_.insert(bytes_.end(), text.begin() + at, text.begin() + at + n);
+    }
+  }
+
+  const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+  bool save(const char* path) const {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes_.data()), bytes_.size());
+    return bool(out);
+  }
+
+private:
+  uint32_t baud_;
+  std::vector<uint8_t> bytes_;
+};
+
+/// Calls f(us, bytes, len) for each record of a capture; false if it is
+/// not one or ends mid-record.
+template <typename F>
+bool forEachRecord(const std::vector<uint8_t>& buf, F&& f) {
+  if (buf.size() < sizeof(capture::MAGIC) ||
+      memcmp(buf.data(), capture::MAGIC, sizeof(capture::MAGIC)))
+    return false;
+  size_t off = sizeof(capture::MAGIC);
+  while (off + capture::HEADER_LEN <= buf.size()) {
+    uint32_t us;
+    uint16_t len;
+    capture::getHeader(&buf[off], us, len);
+    off += capture::HEADER_LEN;
+    if (off + len > buf.size()) return false;
+    f(us, &buf[off], size_t(len));
+    off += len;
+  }
+  return off == buf.size();
+}
+
+inline std::vector<uint8_t> readFile(const char* path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+}
+
+/// Advance a GpsData's UTC clock (and date) by `ms`.
+inline void tick(GpsData& d, uint32_t ms) {
+  uint32_t t = ((d.hour * 60u + d.minute) * 60u + d.second) * 1000u + d.millis + ms;
+  if (t >= 86'400'000u) {
+    t -= 86'400'000u;
+    d.day = uint8_t(d.day % 28 + 1);
+  }
+  d.millis = uint16_t(t % 1000);
+  d.second = uint8_t(t / 1000 % 60);
+  d.minute = uint8_t(t / 60'000 % 60);
+  d.hour   = uint8_t(t / 3'600'000);
+}
+
+}  // namespace synth
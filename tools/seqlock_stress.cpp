@@ -0,0 +1,122 @@
+// seqlock_stress.cpp — one writer thread storing into a Seqlock as fast as
+// it can while reader threads load from it, checking that no snapshot is
+// ever torn (half one store, half another) or older than one already seen.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -pthread -I.. -o seqlock_stress seqlock_stress.cpp
+//
+//   seqlock_stress [seconds] [readers]      # default 2 s, 3 readers
+//
+// Two payloads run back to back: a 256-byte block, wide enough that a
+// store is likely to be caught midway, and GpsData as GpsManager publishes
+// it.  Every field of a payload is derived from one counter, so a reader
+// can tell a torn copy from a whole one.  Exits non-zero on any tear.
+#include "GpsData.h"
+#include "Seqlock.h"
+#include "host_check.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+struct Block {
+  uint32_t w[64];
+};
+
+static void fill(Block& b, uint32_t n) {
+  for (uint32_t i = 0; i < 64; ++i) b.w[i] = n * 64 + i;
+}
+
+static bool whole(const Block& b, uint32_t& n) {
+  n = b.w[0] / 64;
+  for (uint32_t i = 0; i < 64; ++i)
+    if (b.w[i] != n * 64 + i) return false;
+  return true;
+}
+
+static void fill(GpsData& d, uint32_t n) {
+  d = GpsData{};
+  d.seq        = n;
+  d.parts      = uint8_t(n & GPS_PART_ALL);
+  d.fix        = n & 1;
+  d.fixQuality = uint8_t(n % 3);
+  d.pos        = Geo{ int32_t(n * 7), -int32_t(n * 13) };
+  d.second     = uint8_t(n % 60);
+  d.millis     = uint16_t(n % 1000);
+  d.sats       = uint8_t(n % 32);
+  d.hdop       = float(n % 1000);
+  d.speedKnots = float(n % 4096) * 0.5f;
+  d.trackAngle = float(n % 360);
+}
+
+static bool whole(const GpsData& d, uint32_t& n) {
+  n = d.seq;
+  GpsData want;
+  fill(want, n);
+  return d.parts == want.parts && d.fix == want.fix &&
+         d.fixQuality == want.fixQuality && d.pos.lat == want.pos.lat &&
+         d.pos.lon == want.pos.lon && d.second == want.second &&
+         d.millis == want.millis && d.sats == want.sats &&
+         d.hdop == want.hdop && d.speedKnots == want.speedKnots &&
+         d.trackAngle == want.trackAngle;
+}
+
+template <typename T>
+static void run(const char* name, double seconds, unsigned readers) {
+  Seqlock<T> lock;
+  std::atomic<bool> stop{ false };
+  std::atomic<uint64_t> loads{ 0 }, torn{ 0 }, backwards{ 0 };
+  uint32_t stores = 0;
+  T v;
+  fill(v, 0);              // readers never see the zeroed initial value
+  lock.store(v);
+
+  std::vector<std::thread> pool;
+  for (unsigned r = 0; r < readers; ++r)
+    pool.emplace_back([&] {
+      uint64_t mine = 0, bad = 0, back = 0;
+      uint32_t last = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        uint32_t n;
+        if (!whole(lock.load(), n)) ++bad;
+        else if (n < last) ++back;
+        else last = n;
+        ++mine;
+      }
+      loads += mine;
+      torn += bad;
+      backwards += back;
+    });
+
+  auto end = std::chrono::steady_clock::now() +
+             std::chrono::duration<double>(seconds);
+  while (std::chrono::steady_clock::now() < end)
+    for (int i = 0; i < 1000; ++i) {
+      fill(v, ++stores);
+      lock.store(v);
+    }
+  stop = true;
+  for (std::thread& t : pool) t.join();
+
+  printf("%-8s %u readers: %10u stores, %12llu loads, %llu torn, "
+         "%llu out of order\n", name, readers, stores,
+         (unsigned long long)loads.load(), (unsigned long long)torn.load(),
+         (unsigned long long)backwards.load());
+  CHECK(torn == 0);
+  CHECK(backwards == 0);
+  CHECK(lock.version() == stores + 1);
+  uint32_t n;
+  CHECK(whole(lock.load(), n) && n == stores);
+}
+
+int main(int argc, char** argv) {
+  double   seconds = argc > 1 ? atof(argv[1]) : 2.0;
+  unsigned readers = argc > 2 ? unsigned(atoi(argv[2])) : 3;
+  printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+  run<Block>("256 B", seconds, readers);
+  run<GpsData>("GpsData", seconds, readers);
+  return checkSummary(argv[0]);
+}
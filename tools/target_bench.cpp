@@ -0,0 +1,153 @@
+// target_bench.cpp — TargetTable::solve() against a one-target-at-a-time
+// reference, then its cost from 3 to 64 targets.
+//
+//   cd tools
+//   g++ -std=c++17 -O2 -I.. -o target_bench target_bench.cpp ../TargetTable.cpp ../Geo.cpp
+//   g++ -std=c++17 -O2 -I.. -U__SSE__ -o target_bench_fpu target_bench.cpp ../TargetTable.cpp ../Geo.cpp
+//
+// The distance loop runs four lanes at a time where the build has SSE or
+// NEON and on the FPU otherwise; the second build forces the FPU loop on
+// an x86 host.  Every table size from 3 to 64 is checked in each, so both
+// the vector lanes and the scalar tail are covered, and the checksum line
+// has to come out the same from every build.  Exits non-zero if any check
+// fails.
+#include "TargetTable.h"
+#include "host_check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+static const char* PATH =
+#if defined(__SSE__)
+  "SSE";
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  "NEON";
+#else
+  "FPU";
+#endif
+
+static const TargetKind KINDS[] = { TargetKind::Pin, TargetKind::Front,
+                                    TargetKind::Back, TargetKind::Hazard,
+                                    TargetKind::Layup };
+
+// A hole's worth of targets up to 600 m from the tee at the origin.
+static void fill(TargetTable& t, size_t n, Rng& rng) {
+  t.clear();
+  for (size_t i = 0; i < n; ++i) {
+    TargetKind k = i < 3 ? KINDS[i] : KINDS[3 + rng.next() % 2];
+    geo::Vec2 p{ float(rng.uniform(-120, 120)), float(rng.uniform(-50, 600)) };
+    CHECK(t.add(k, p, uint8_t(i), float(rng.uniform(0, 25))) == int(i));
+  }
+}
+
+static uint32_t bits(float f) {
+  uint32_t u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static void equivalence() {
+  Geo origin = geo::fromDegrees(-25.9004, 28.2019);
+  geo::LocalFrame frame(origin, geo::Earth::Wgs84);
+  Rng rng(31);
+  TargetTable t;
+  uint32_t sum = 2166136261u;                     // FNV-1a over the results
+  size_t solves = 0, inexact = 0;
+  double worstRel = 0, worstBearing = 0;
+  size_t aheadChecked = 0;
+
+  for (size_t n = 3; n <= TargetTable::MAX_TARGETS; ++n) {
+    for (int rep = 0; rep < 200; ++rep, ++solves) {
+      fill(t, n, rng);
+      geo::Vec2 from{ float(rng.uniform(-60, 60)), float(rng.uniform(-20, 450)) };
+      t.solve(from, frame);
+
+      for (size_t i = 0; i < n; ++i) {
+        // what the lanes compute, one target at a time through the frame
+        geo::Vec2 d = frame.delta(from, t.position(i));
+        float ref = sqrtf(d.x * d.x + d.y * d.y);
+        inexact += bits(t.distance(i)) != bits(ref);
+
+        double dd = hypot(double(d.x), double(d.y));
+        if (dd > 1.0) worstRel = fmax(worstRel, fabs(t.distance(i) - dd) / dd);
+
+        double b = atan2(double(d.x), double(d.y)) * 180.0 / M_PI;
+        if (b < 0) b += 360.0;
+        double eb = fabs(t.bearing(i) - b);
+        worstBearing = fmax(worstBearing, fmin(eb, 360.0 - eb));
+        CHECK(t.bearing(i) >= 0.0f && t.bearing(i) < 360.0f);
+
+        for (uint32_t u : { bits(t.distance(i)), uint32_t(lroundf(t.bearing(i) * 100)) })
+          for (int k = 0; k < 4; ++k) sum = (sum ^ uint8_t(u >> (8 * k))) * 16777619u;
+      }
+
+      // ahead() against a sort over everything the corridor takes
+      int line = int(rng.next() % n);
+      float corridor = float(rng.uniform(5, 40));
+      TargetAhead got[8];
+      size_t m = t.ahead(line, TargetKind::Hazard, corridor, got, 8);
+      std::vector<TargetAhead> want;
+      double len = t.distance(line);
+      geo::Vec2 dl = frame.delta(from, t.position(line));
+      for (size_t i = 0; i < n; ++i) {
+        if (t.kind(i) != TargetKind::Hazard || len <= 0) continue;
+        geo::Vec2 d = frame.delta(from, t.position(i));
+        double along = (d.x * dl.x + d.y * dl.y) / len;
+        double lat = (d.x * dl.y - d.y * dl.x) / len, r = t.radius(i);
+        // leave out anything a rounding away from the edge either way
+        if (along + r <= 0 || along - r >= len || fabs(lat) - r > corridor) continue;
+        want.push_back(TargetAhead{ uint8_t(i), float(along - r), float(along + r),
+                                    float(lat) });
+      }
+      std::sort(want.begin(), want.end(),
+                [](const TargetAhead& a, const TargetAhead& b) { return a.reach < b.reach; });
+      if (want.size() > 8) want.resize(8);
+      CHECK(m == want.size());
+      for (size_t k = 0; k < m && k < want.size(); ++k) {
+        CHECK(got[k].slot == want[k].slot);
+        CHECK_NEAR(got[k].reach, want[k].reach, 1e-3);
+        CHECK_NEAR(got[k].lateral, want[k].lateral, 1e-3);
+        ++aheadChecked;
+      }
+    }
+  }
+
+  printf("%s build: %zu solves of 3..64 targets: %zu distances off the "
+         "one-at-a-time result, worst %.1e relative to double, bearing %.1e deg; "
+         "%zu ahead() picks match\n",
+         PATH, solves, inexact, worstRel, worstBearing, aheadChecked);
+  printf("checksum %08x\n", sum);
+  CHECK(inexact == 0);
+  CHECK(worstRel < 2e-7);
+  CHECK(worstBearing < 1e-3);                     // 1.2e-5 rad, Tier::Mid
+}
+
+static void benchmark() {
+  geo::LocalFrame frame(geo::fromDegrees(-25.9004, 28.2019), geo::Earth::Wgs84);
+  Rng rng(37);
+  static const size_t SIZES[] = { 3, 4, 5, 8, 12, 16, 24, 32, 48, 64 };
+  printf("%s build, ns per solve():", PATH);
+  for (size_t n : SIZES) {
+    TargetTable t;
+    fill(t, n, rng);
+    geo::Vec2 from[64];
+    for (geo::Vec2& f : from)
+      f = geo::Vec2{ float(rng.uniform(-60, 60)), float(rng.uniform(-20, 450)) };
+    float acc = 0;
+    double ns = nsPer(200'000, [&](size_t i) {
+      t.solve(from[i & 63], frame);
+      acc += t.distance(n - 1);
+    });
+    keep(acc);
+    printf("  %zu: %.0f (%.1f/target)", n, ns, ns / n);
+  }
+  printf("\n");
+}
+
+int main(int, char** argv) {
+  equivalence();
+  benchmark();
+  return checkSummary(argv[0]);
+}